@@ -0,0 +1,531 @@
+#include "Bareinfo_Aggregate.h"
+#include "Bareinfo_Export.h"
+#include "Bareinfo_Fields.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string_view>
+#include <unordered_map>
+
+// =============================
+// HELPERS
+// =============================
+namespace {
+const char* RAM_PATH   = "System.TotalRAM_GB";
+const char* CORES_PATH = "CPU.Cores";
+const char* MISSING    = "(missing)";
+constexpr int MAX_DEPTH = 64;
+
+// Every distinct group value is stored once, groups refer to it by id
+class StringPool {
+public:
+    uint32_t intern(std::string_view s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) return it->second;
+        // deque never moves its elements, so the views stay valid
+        strings.emplace_back(s);
+        uint32_t id = static_cast<uint32_t>(strings.size() - 1);
+        ids.emplace(strings.back(), id);
+        return id;
+    }
+
+    const std::string& get(uint32_t id) const { return strings[id]; }
+
+private:
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+struct KeyHash {
+    size_t operator()(const std::vector<uint32_t>& key) const {
+        uint64_t h = 1469598103934665603ull;  // FNV-1a over the ids
+        for (uint32_t id : key) {
+            h ^= id;
+            h *= 1099511628211ull;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+// Buffered reader, the inputs can be gigabytes of NDJSON. It remembers where
+// the current record started, so after a torn NDJSON line it can go back to
+// the start of the next line instead of taking the (valid) record there down
+// with it. Bytes are only copied aside when the buffer is refilled mid record.
+class Reader {
+public:
+    explicit Reader(FILE* in) : in(in) {}
+
+    int peek() {
+        if (pos == len && !fill()) return EOF;
+        return static_cast<unsigned char>(buf[pos]);
+    }
+
+    int get() {
+        int c = peek();
+        if (c != EOF) ++pos;
+        return c;
+    }
+
+    void skipWhitespace() {
+        for (int c = peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = peek()) ++pos;
+    }
+
+    void skipLine() {
+        for (int c = get(); c != EOF && c != '\n'; c = get()) {}
+    }
+
+    // Called at the start of every record
+    void mark() {
+        marking = true;
+        markPos = pos;
+        kept.clear();
+    }
+
+    void unmark() {
+        marking = false;
+        kept.clear();
+    }
+
+    // After a broken record: goes back to the line after the one the record
+    // started on, or finishes the current line if it never got past it
+    void rewind() {
+        marking = false;
+        kept.append(buf, markPos, pos - markPos);
+        size_t nl = kept.find('\n');
+        if (nl == std::string::npos) {
+            kept.clear();
+            skipLine();
+            return;
+        }
+        buf = kept.substr(nl + 1) + buf.substr(pos, len - pos);
+        kept.clear();
+        pos = 0;
+        len = buf.size();
+    }
+
+    // Skips lines until one that starts with '{' (leading blanks allowed)
+    void skipToRecord() {
+        for (;;) {
+            int c = peek();
+            while (c == ' ' || c == '\t' || c == '\r') {
+                ++pos;
+                c = peek();
+            }
+            if (c == '{' || c == EOF) return;
+            skipLine();
+        }
+    }
+
+private:
+    // Out of line so that peek() and get() stay small enough to be inlined
+    // into the parser, they run once per input byte
+    [[gnu::noinline]] bool fill() {
+        // The record being parsed may still need rewinding, keep its bytes
+        if (marking) {
+            kept.append(buf, markPos, len - markPos);
+            markPos = 0;
+        }
+        buf.resize(1 << 16);
+        len = std::fread(&buf[0], 1, buf.size(), in);
+        pos = 0;
+        return len > 0;
+    }
+
+    FILE* in;
+    std::string buf;
+    size_t pos = 0;
+    size_t len = 0;
+
+    bool marking = false;  // inside a record
+    size_t markPos = 0;    // where it starts in buf (0 after a refill)
+    std::string kept;      // its bytes from earlier buffers
+};
+
+void appendUTF8(std::string& out, unsigned cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Reads the 4 hex digits of a \u escape
+bool readHex4(Reader& r, unsigned& out) {
+    out = 0;
+    for (int i = 0; i < 4; ++i) {
+        int h = r.get();
+        if (h >= '0' && h <= '9') out = out * 16 + static_cast<unsigned>(h - '0');
+        else if (h >= 'a' && h <= 'f') out = out * 16 + static_cast<unsigned>(h - 'a' + 10);
+        else if (h >= 'A' && h <= 'F') out = out * 16 + static_cast<unsigned>(h - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+// The part of a string after "\u", surrogate pairs become one code point.
+// Kept out of parseString so its hot loop stays small.
+bool parseUnicodeEscape(Reader& r, std::string& out) {
+    unsigned cp;
+    if (!readHex4(r, cp)) return false;
+    if (cp >= 0xD800 && cp <= 0xDBFF) {
+        // UTF-16 surrogate pair, the low half has to follow
+        unsigned low;
+        if (r.get() != '\\' || r.get() != 'u' || !readHex4(r, low)) return false;
+        if (low < 0xDC00 || low > 0xDFFF) return false;
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+        cp = 0xFFFD;  // lone low surrogate
+    }
+    appendUTF8(out, cp);
+    return true;
+}
+
+std::string formatStats(const NumberStats& s) {
+    if (!s.count) return "-";
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%g / %.4g / %g", s.min, s.mean, s.max);
+    return buf;
+}
+
+std::string statsJSON(const NumberStats& s) {
+    if (!s.count) return "null";
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "{\"count\":%llu,\"min\":%g,\"mean\":%g,\"max\":%g,\"stddev\":%g}",
+                  static_cast<unsigned long long>(s.count), s.min, s.mean, s.max, s.stddev());
+    return buf;
+}
+} // namespace
+
+// =============================
+// STATS
+// =============================
+void NumberStats::add(double x) {
+    ++count;
+    if (count == 1) {
+        min = max = x;
+    } else {
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+    double delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+}
+
+double NumberStats::stddev() const {
+    return count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+}
+
+// =============================
+// AGGREGATOR
+// =============================
+struct Aggregator::Impl {
+    std::vector<std::string> groupBy;
+
+    // Paths we keep from each record: the group keys, then RAM and cores
+    std::unordered_map<std::string, size_t> wanted;
+    std::vector<size_t> groupSlots;
+    size_t ramSlot = 0, coresSlot = 0;
+    std::vector<std::string> values;
+    std::vector<bool> present;
+
+    StringPool pool;
+    std::unordered_map<std::vector<uint32_t>, GroupStats, KeyHash> groups;
+    std::vector<uint32_t> scratch;
+
+    uint64_t records = 0;
+    uint64_t badRecords = 0;
+
+    void leaf(const std::string& path, std::string&& value) {
+        auto it = wanted.find(path);
+        if (it == wanted.end()) return;
+        values[it->second] = std::move(value);
+        present[it->second] = true;
+    }
+
+    bool parseString(Reader& r, std::string& out) {
+        if (r.get() != '"') return false;
+        out.clear();
+        for (;;) {
+            int c = r.get();
+            if (c == EOF || c < 0x20) return false;  // raw newlines mean a torn line
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += static_cast<char>(c);
+                continue;
+            }
+            switch (c = r.get()) {
+                case '"': case '\\': case '/': out += static_cast<char>(c); break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': if (!parseUnicodeEscape(r, out)) return false; break;
+                default: return false;
+            }
+        }
+    }
+
+    // Walks one JSON value, path is the dotted path of the value ("BIOS.Version")
+    bool parseValue(Reader& r, std::string& path, int depth) {
+        if (depth > MAX_DEPTH) return false;
+        r.skipWhitespace();
+        int c = r.peek();
+
+        if (c == '{' || c == '[') {
+            bool object = c == '{';
+            char close = object ? '}' : ']';
+            r.get();
+            r.skipWhitespace();
+            if (r.peek() == close) {
+                r.get();
+                return true;
+            }
+
+            std::string key;
+            for (size_t index = 0;; ++index) {
+                r.skipWhitespace();
+                if (object) {
+                    if (!parseString(r, key)) return false;
+                    r.skipWhitespace();
+                    if (r.get() != ':') return false;
+                } else {
+                    key = std::to_string(index);
+                }
+
+                size_t len = path.size();
+                if (!path.empty()) path += '.';
+                path += key;
+                bool ok = parseValue(r, path, depth + 1);
+                path.resize(len);
+                if (!ok) return false;
+
+                r.skipWhitespace();
+                c = r.get();
+                if (c == close) return true;
+                if (c != ',') return false;
+            }
+        }
+
+        std::string value;
+        if (c == '"') {
+            if (!parseString(r, value)) return false;
+        } else {
+            // number, true, false or null
+            for (c = r.peek(); c != EOF && !std::strchr(",}] \t\r\n", c); c = r.peek()) {
+                value += static_cast<char>(r.get());
+            }
+            if (value.empty()) return false;
+        }
+        leaf(path, std::move(value));
+        return true;
+    }
+
+    void record() {
+        ++records;
+
+        scratch.clear();
+        for (size_t i = 0; i < groupBy.size(); ++i) {
+            size_t slot = groupSlots[i];
+            scratch.push_back(pool.intern(present[slot] ? std::string_view(values[slot]) : MISSING));
+        }
+
+        auto it = groups.find(scratch);
+        if (it == groups.end()) it = groups.emplace(scratch, GroupStats{}).first;
+        GroupStats& stats = it->second;
+        ++stats.records;
+
+        char* end = nullptr;
+        if (present[ramSlot]) {
+            double ram = std::strtod(values[ramSlot].c_str(), &end);
+            if (end != values[ramSlot].c_str()) stats.ram.add(ram);
+        }
+        if (present[coresSlot]) {
+            double cores = std::strtod(values[coresSlot].c_str(), &end);
+            if (end != values[coresSlot].c_str()) stats.cores.add(cores);
+        }
+    }
+};
+
+Aggregator::Aggregator(std::vector<std::string> groupBy) : impl(new Impl) {
+    impl->groupBy = std::move(groupBy);
+    for (const std::string& path : impl->groupBy) {
+        impl->groupSlots.push_back(impl->wanted.emplace(path, impl->wanted.size()).first->second);
+    }
+
+    // A group key may also be RAM or cores, the stats then share its slot
+    impl->ramSlot = impl->wanted.emplace(RAM_PATH, impl->wanted.size()).first->second;
+    impl->coresSlot = impl->wanted.emplace(CORES_PATH, impl->wanted.size()).first->second;
+    impl->values.resize(impl->wanted.size());
+    impl->present.resize(impl->wanted.size());
+}
+
+Aggregator::~Aggregator() = default;
+
+void Aggregator::consume(FILE* in) {
+    Reader r(in);
+    std::string path;
+
+    for (;;) {
+        r.skipWhitespace();
+        int c = r.peek();
+        if (c == EOF) break;
+
+        // Every record is an object, anything else is garbage
+        std::fill(impl->present.begin(), impl->present.end(), false);
+        path.clear();
+        r.mark();
+        if (c == '{' && impl->parseValue(r, path, 0)) {
+            r.unmark();
+            impl->record();
+        } else {
+            // One bad record for the whole broken stretch, then carry on at
+            // the next line that can start a record
+            ++impl->badRecords;
+            r.rewind();
+            r.skipToRecord();
+        }
+    }
+}
+
+AggregateResult Aggregator::result() const {
+    AggregateResult result;
+    result.records = impl->records;
+    result.badRecords = impl->badRecords;
+    result.groups.reserve(impl->groups.size());
+
+    for (const auto& [ids, stats] : impl->groups) {
+        AggregateGroup group;
+        for (uint32_t id : ids) group.key.push_back(impl->pool.get(id));
+        group.stats = stats;
+        result.groups.push_back(std::move(group));
+    }
+
+    std::sort(result.groups.begin(), result.groups.end(), [](const AggregateGroup& a, const AggregateGroup& b) {
+        if (a.stats.records != b.stats.records) return a.stats.records > b.stats.records;
+        return a.key < b.key;
+    });
+    return result;
+}
+
+// =============================
+// COMMAND
+// =============================
+bool parseAggregateArgs(int argc, char* argv[], AggregateOptions& options, std::string& error) {
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--by") {
+            if (i + 1 >= argc) {
+                error = "--by needs a comma separated list of fields";
+                return false;
+            }
+            std::string spec = argv[++i];
+            size_t pos = 0;
+            while (pos <= spec.size()) {
+                size_t end = spec.find(',', pos);
+                if (end == std::string::npos) end = spec.size();
+                std::string name = spec.substr(pos, end - pos);
+                pos = end + 1;
+                if (name.empty()) continue;
+
+                // Registry names map to their JSON path, anything else is used as a path
+                if (const Field* f = findField(name)) {
+                    if (!f->jsonKey) {
+                        error = name + " only exists in the text output";
+                        return false;
+                    }
+                    name = std::string(f->section) + "." + f->jsonKey;
+                }
+                options.groupBy.push_back(name);
+            }
+        } else if (arg == "--ndjson") {
+            options.ndjson = true;
+        } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+            error = "Unknown argument: " + arg;
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+
+    if (options.groupBy.empty()) {
+        error = "aggregate needs --by, e.g. --by bios.version,board.product_name";
+        return false;
+    }
+    if (options.inputs.empty()) options.inputs.push_back("-");
+    return true;
+}
+
+int RunAggregate(int argc, char* argv[]) {
+    AggregateOptions options;
+    std::string error;
+    if (!parseAggregateArgs(argc, argv, options, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    Aggregator aggregator(options.groupBy);
+    for (const std::string& input : options.inputs) {
+        if (input == "-") {
+            aggregator.consume(stdin);
+            continue;
+        }
+        std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(input.c_str(), "rb"), std::fclose);
+        if (!file) {
+            std::cerr << "Can't open " << input << std::endl;
+            return 1;
+        }
+        aggregator.consume(file.get());
+    }
+
+    AggregateResult result = aggregator.result();
+
+    if (options.ndjson) {
+        for (const AggregateGroup& g : result.groups) {
+            std::string line = "{\"key\":{";
+            for (size_t i = 0; i < g.key.size(); ++i) {
+                if (i) line += ',';
+                line += '"' + jsonEscape(options.groupBy[i]) + "\":\"" + jsonEscape(g.key[i]) + '"';
+            }
+            line += "},\"count\":" + std::to_string(g.stats.records);
+            line += ",\"ram_gb\":" + statsJSON(g.stats.ram);
+            line += ",\"cores\":" + statsJSON(g.stats.cores) + "}\n";
+            std::cout << line;
+        }
+        return 0;
+    }
+
+    std::cout << "Records: " << result.records;
+    if (result.badRecords) std::cout << " (" << result.badRecords << " could not be parsed)";
+    std::cout << "\nGroups:  " << result.groups.size() << "\n\n";
+
+    char buf[256];
+    std::string header;
+    for (size_t i = 0; i < options.groupBy.size(); ++i) header += (i ? " | " : "") + options.groupBy[i];
+    std::snprintf(buf, sizeof(buf), "%10s  %-28s  %-20s  ", "Count", "RAM GB min/avg/max", "Cores min/avg/max");
+    std::cout << buf << header << "\n";
+
+    for (const AggregateGroup& g : result.groups) {
+        std::string key;
+        for (size_t i = 0; i < g.key.size(); ++i) key += (i ? " | " : "") + g.key[i];
+        std::snprintf(buf, sizeof(buf), "%10llu  %-28s  %-20s  ", static_cast<unsigned long long>(g.stats.records),
+                      formatStats(g.stats.ram).c_str(), formatStats(g.stats.cores).c_str());
+        std::cout << buf << key << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// =============================
+// FLEET AGGREGATION
+// =============================
+// Merges many bareinfo.json snapshots or an NDJSON stream (--ndjson output)
+// into per group counts. Records are parsed one at a time and thrown away,
+// so memory only grows with the number of distinct group keys.
+
+struct AggregateOptions {
+    std::vector<std::string> groupBy;  // JSON paths, e.g. "BIOS.Version"
+    std::vector<std::string> inputs;   // files, "-" is stdin
+    bool ndjson = false;               // print the groups as NDJSON
+};
+
+// Parses the arguments after "aggregate", field names such as bios.version
+// are turned into their JSON path
+bool parseAggregateArgs(int argc, char* argv[], AggregateOptions& options, std::string& error);
+
+// Running min/max/mean/variance (Welford)
+struct NumberStats {
+    uint64_t count = 0;
+    double min = 0, max = 0, mean = 0, m2 = 0;
+
+    void add(double x);
+    double stddev() const;
+};
+
+struct GroupStats {
+    uint64_t records = 0;
+    NumberStats ram;    // System.TotalRAM_GB
+    NumberStats cores;  // CPU.Cores
+};
+
+struct AggregateGroup {
+    std::vector<std::string> key;  // one value per groupBy path
+    GroupStats stats;
+};
+
+struct AggregateResult {
+    uint64_t records = 0;
+    uint64_t badRecords = 0;
+    std::vector<AggregateGroup> groups;  // sorted by record count, biggest first
+};
+
+class Aggregator {
+public:
+    explicit Aggregator(std::vector<std::string> groupBy);
+    ~Aggregator();
+
+    Aggregator(const Aggregator&) = delete;
+    Aggregator& operator=(const Aggregator&) = delete;
+
+    // Streams every JSON document in the file (pretty printed or NDJSON).
+    // Records must be objects. A broken stretch of input (torn line,
+    // garbage) counts as one bad record and parsing picks up again at the
+    // next line starting with '{'.
+    void consume(FILE* in);
+
+    AggregateResult result() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+// Runs "bareinfo aggregate ..." and prints the table (or NDJSON) to stdout
+int RunAggregate(int argc, char* argv[]);
@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Bareinfo_Aggregate.h"
+
+// Regression checks for the aggregate parser, run by ctest. Every case feeds
+// a string through Aggregator::consume and compares the counts per group.
+
+namespace {
+int failures = 0;
+
+struct Expect {
+    std::string key;
+    uint64_t count;
+};
+
+void check(const char* name, const std::string& input, uint64_t records, uint64_t bad,
+           const std::vector<Expect>& groups) {
+    Aggregator aggregator({"BIOS.Version"});
+    FILE* in = fmemopen(const_cast<char*>(input.data()), input.size(), "r");
+    if (!in) {
+        std::printf("FAIL %s: fmemopen\n", name);
+        ++failures;
+        return;
+    }
+    aggregator.consume(in);
+    std::fclose(in);
+
+    AggregateResult result = aggregator.result();
+    bool ok = result.records == records && result.badRecords == bad && result.groups.size() == groups.size();
+    for (size_t i = 0; ok && i < groups.size(); ++i) {
+        ok = result.groups[i].key[0] == groups[i].key && result.groups[i].stats.records == groups[i].count;
+    }
+
+    if (ok) {
+        std::printf("ok   %s\n", name);
+        return;
+    }
+    ++failures;
+    std::printf("FAIL %s: %llu records, %llu bad, groups:", name, static_cast<unsigned long long>(result.records),
+                static_cast<unsigned long long>(result.badRecords));
+    for (const AggregateGroup& g : result.groups) {
+        std::printf(" [%s]=%llu", g.key[0].c_str(), static_cast<unsigned long long>(g.stats.records));
+    }
+    std::printf("\n");
+}
+} // namespace
+
+int main() {
+    check("ndjson",
+          "{\"BIOS\":{\"Version\":\"a\"}}\n{\"BIOS\":{\"Version\":\"b\"}}\n{\"BIOS\":{\"Version\":\"a\"}}\n",
+          3, 0, {{"a", 2}, {"b", 1}});
+
+    // The torn line must not take the valid record after it down
+    check("torn line",
+          "{\"BIOS\":{\"Version\":\"y\"\n{\"BIOS\":{\"Version\":\"z\"}}\n",
+          1, 1, {{"z", 1}});
+    check("torn inside a string",
+          "{\"BIOS\":{\"Version\":\"y\n{\"BIOS\":{\"Version\":\"z\"}}\n",
+          1, 1, {{"z", 1}});
+    check("torn last line", "{\"BIOS\":{\"Version\":\"z\"}}\n{\"BIOS\":{\"Ver", 1, 1, {{"z", 1}});
+
+    check("garbage line", "hello world\n{\"BIOS\":{\"Version\":\"z\"}}\n", 1, 1, {{"z", 1}});
+    check("top level scalars", "42\n\"x\"\n[1,2]\n", 0, 1, {});
+
+    check("pretty documents",
+          "{\n  \"BIOS\": {\n    \"Version\": \"a\"\n  },\n  \"CPU\": {\n    \"Cores\": \"8\"\n  }\n}\n"
+          "{\n  \"BIOS\": {\n    \"Version\": \"b\"\n  }\n}\n",
+          2, 0, {{"a", 1}, {"b", 1}});
+    check("broken pretty document",
+          "{\n  \"BIOS\": {\n    \"Version\": \"a\"\n  ,,\n}\n{\n  \"BIOS\": {\n    \"Version\": \"b\"\n  }\n}\n",
+          1, 1, {{"b", 1}});
+
+    check("missing key", "{\"CPU\":{}}\n", 1, 0, {{"(missing)", 1}});
+    check("escapes", "{\"BIOS\":{\"Version\":\"\\u00e9\\n\\\"\"}}\n", 1, 0, {{"\xc3\xa9\n\"", 1}});
+    check("surrogate pair", "{\"BIOS\":{\"Version\":\"\\uD83D\\uDE00\"}}\n", 1, 0, {{"\xf0\x9f\x98\x80", 1}});
+    check("broken surrogate pair", "{\"BIOS\":{\"Version\":\"\\uD83Dx\"}}\n", 0, 1, {});
+
+    std::printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
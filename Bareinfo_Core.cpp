@@ -0,0 +1,227 @@
+#include "Bareinfo_Core.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================
+// FILE HELPERS
+// =============================
+IOCounters& ioCounters() {
+    static IOCounters counters;
+    return counters;
+}
+
+bool readFile(const std::string& path, std::string& out) {
+    out.clear();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    ++ioCounters().filesOpened;
+
+    // sysfs and procfs report bogus sizes, so just read until EOF
+    char buf[4096];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0) {
+        out.append(buf, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    ioCounters().bytesRead += out.size();
+    return n == 0;
+}
+
+std::string readFirstLine(const std::string& path) {
+    std::string data;
+    if (!readFile(path, data)) return "N/A";
+    std::string line = data.substr(0, data.find('\n'));
+    return line.empty() ? "N/A" : line;
+}
+
+std::string readline(const std::string& path, const std::string& word) {
+    std::string data;
+    if (!readFile(path, data)) return "N/A";
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        if (end == std::string::npos) end = data.size();
+        std::string line = data.substr(pos, end - pos);
+        if (line.find(word) != std::string::npos) {
+            return line.substr(line.find(":") + 2);
+        }
+        pos = end + 1;
+    }
+    return "N/A";
+}
+
+bool pathExists(const char* path) {
+    ++ioCounters().pathLookups;
+    struct stat st;
+    return ::stat(path, &st) == 0;
+}
+
+std::vector<std::string> listDirectory(const std::string& path) {
+    std::vector<std::string> names;
+    DIR* d = ::opendir(path.c_str());
+    if (!d) return names;
+    ++ioCounters().filesOpened;
+
+    while (dirent* entry = ::readdir(d)) {
+        if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0) continue;
+        names.emplace_back(entry->d_name);
+    }
+    ::closedir(d);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// =============================
+// SYSTEM FUNCTIONS
+// =============================
+
+// Finds the SecureBoot-<guid> entry in an efivars/vars directory
+static std::string findSecureBootVar(const char* dir) {
+    DIR* d = ::opendir(dir);
+    if (!d) return "";
+    ++ioCounters().filesOpened;
+
+    std::string found;
+    while (dirent* entry = ::readdir(d)) {
+        if (std::strncmp(entry->d_name, "SecureBoot-", 11) == 0) {
+            found = std::string(dir) + "/" + entry->d_name;
+            break;
+        }
+    }
+    ::closedir(d);
+    return found;
+}
+
+std::string CheckSecureBoot() {
+    if (!pathExists("/sys/firmware/efi")) return "N/A (Legacy BIOS)";
+
+    // efivarfs stores 4 attribute bytes before the value, the old sysfs
+    // "vars" interface exposes the raw value in a "data" file instead
+    std::string varPath;
+    size_t valueOffset = 4;
+    if (pathExists("/sys/firmware/efi/efivars")) {
+        varPath = findSecureBootVar("/sys/firmware/efi/efivars");
+    } else if (pathExists("/sys/firmware/efi/vars")) {
+        varPath = findSecureBootVar("/sys/firmware/efi/vars");
+        if (!varPath.empty()) varPath += "/data";
+        valueOffset = 0;
+    } else {
+        return "N/A (No efivars directory)";
+    }
+
+    if (varPath.empty()) return "N/A (No SecureBoot variable)";
+
+    int fd = ::open(varPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return "Unknown (Permission denied)";
+
+    unsigned char data[5] = {0};
+    ssize_t size = ::read(fd, data, sizeof(data));
+    ::close(fd);
+    ++ioCounters().filesOpened;
+    if (size > 0) ioCounters().bytesRead += static_cast<uint64_t>(size);
+
+    if (size < 0) return "Unknown (Read error)";
+    if (size == 0) return "Unknown (Empty variable)";
+
+    // Try byte 4 (standard layout), fallback to byte 0 (some kernels)
+    unsigned char state = (size > static_cast<ssize_t>(valueOffset)) ? data[valueOffset] : data[0];
+
+    return (state == 1) ? "Enabled" : "Disabled";
+}
+
+std::string getKernelInfo() {
+    return readFirstLine("/proc/sys/kernel/osrelease");
+}
+
+std::string shell() {
+    const char* sh = getenv("SHELL");
+    return sh ? std::string(sh) : "N/A";
+}
+
+std::string getPackageManager() {
+    struct Manager {
+        const char* name;
+        const char* paths[2];
+    };
+    static const Manager managers[] = {
+        {"apt", {"/usr/bin/apt", "/usr/bin/apt-get"}},
+        {"dnf", {"/usr/bin/dnf", nullptr}},
+        {"yum", {"/usr/bin/yum", nullptr}},
+        {"pacman", {"/usr/bin/pacman", nullptr}},
+        {"yay", {"/usr/bin/yay", nullptr}},
+        {"paru", {"/usr/bin/paru", nullptr}},
+        {"zypper", {"/usr/bin/zypper", nullptr}},
+        {"emerge", {"/usr/bin/emerge", nullptr}},
+        {"nix", {"/run/current-system/sw/bin/nix-env", nullptr}},
+        {"snap", {"/usr/bin/snap", nullptr}},
+        {"flatpak", {"/usr/bin/flatpak", nullptr}},
+        {"apk", {"/sbin/apk", nullptr}},
+        {"brew", {"/home/linuxbrew/.linuxbrew/bin/brew", "/usr/bin/brew"}},
+        {"conda", {"/usr/bin/conda", nullptr}},
+        {"pip", {"/usr/bin/pip", nullptr}},
+        {"pkg", {"/usr/sbin/pkg", nullptr}},
+        {"guix", {"/usr/bin/guix", nullptr}}
+    };
+
+    std::string found;
+    for (const auto& manager : managers) {
+        for (const char* path : manager.paths) {
+            if (path && pathExists(path)) {
+                if (!found.empty()) found += ", ";
+                found += manager.name;
+                break;
+            }
+        }
+    }
+
+    return found.empty() ? "unknown" : found;
+}
+
+double getRAMInfo(const std::string& arg) {
+    const char* wanted = nullptr;
+    if (arg == "RAM") wanted = "MemTotal:";
+    else if (arg == "FREE") wanted = "MemAvailable:";
+    else return 0.0;
+
+    std::string meminfo;
+    if (!readFile("/proc/meminfo", meminfo)) return 0.0;
+
+    size_t pos = meminfo.find(wanted);
+    if (pos == std::string::npos) return 0.0;
+
+    long value = std::strtol(meminfo.c_str() + pos + std::strlen(wanted), nullptr, 10);
+    return value / 1048576.0;
+}
+
+std::string BuildInfo() {
+    return readFirstLine("/proc/version");
+}
+
+std::string getDistroInfo() {
+    std::string data;
+    if (!readFile("/etc/os-release", data)) return "N/A";
+
+    size_t pos = data.find("PRETTY_NAME=");
+    if (pos == std::string::npos) return "N/A";
+
+    size_t end = data.find('\n', pos);
+    std::string line = data.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+
+    size_t start = line.find('=') + 1;
+    if (start < line.size() && line[start] == '"') start++;
+    size_t stop = line.find_last_of('"');
+    if (stop == std::string::npos || stop < start) stop = line.size();
+    return line.substr(start, stop - start);
+}
+
+std::string getBootMode() {
+    return pathExists("/sys/firmware/efi") ? "UEFI" : "BIOS";
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The core only uses POSIX I/O (open/read/opendir) so that it can be linked
+// into the static, iostream-free bareinfo_static binary as well as the
+// regular front-ends.
+
+// =============================
+// FILE HELPERS
+// =============================
+
+// Reads a whole file into out, returns false if it can't be opened
+bool readFile(const std::string& path, std::string& out);
+
+// Returns the first line of a file or "N/A"
+std::string readFirstLine(const std::string& path);
+
+// Reads a line from a file matching a specific keyword
+std::string readline(const std::string& path, const std::string& word);
+
+bool pathExists(const char* path);
+
+// One file of a batched read, see readFiles
+struct FileRead {
+    std::string path;
+    std::string data;
+    bool ok = false;
+};
+
+// Reads every file of a collection pass in one go, collectors that touch
+// many small files build the whole list first and call this once.
+// Implemented in Bareinfo_IO.cpp (io_uring or sequential pread).
+void readFiles(std::vector<FileRead>& files);
+
+// Returns the sorted entry names of a directory, without "." and ".."
+std::vector<std::string> listDirectory(const std::string& path);
+
+// Running totals of every open, read and stat done through the helpers above,
+// collectFields() diffs them around each collector for the _meta output
+struct IOCounters {
+    uint64_t filesOpened = 0;  // files and directories
+    uint64_t bytesRead = 0;
+    uint64_t pathLookups = 0;  // pathExists() probes, nothing is opened
+};
+
+IOCounters& ioCounters();
+
+// =============================
+// CPU INFO CLASS
+// =============================
+class CPUInfo {
+public:
+    std::string getCPUName()   { return readline("/proc/cpuinfo", "model name"); }
+    std::string getCPUCores()  { return readline("/proc/cpuinfo", "cpu cores"); }
+    std::string getCPUVendor() { return readline("/proc/cpuinfo", "vendor_id"); }
+};
+
+// =============================
+// BIOS INFO CLASS
+// =============================
+class BIOSInfo {
+public:
+    std::string getBIOSVendor()  { return readFirstLine("/sys/class/dmi/id/bios_vendor"); }
+    std::string getBIOSVersion() { return readFirstLine("/sys/class/dmi/id/bios_version"); }
+    std::string getBIOSDate()    { return readFirstLine("/sys/class/dmi/id/bios_date"); }
+    std::string getBIOSRelease() { return readFirstLine("/sys/class/dmi/id/bios_release"); }
+};
+
+// =============================
+// MOTHERBOARD INFO CLASS
+// =============================
+class MotherboardInfo {
+public:
+    std::string getMotherboardName()   { return readFirstLine("/sys/class/dmi/id/board_name"); }
+    std::string getMotherboardVendor() { return readFirstLine("/sys/class/dmi/id/board_vendor"); }
+    std::string getSystemVendor()      { return readFirstLine("/sys/class/dmi/id/sys_vendor"); }
+    std::string getProductName()       { return readFirstLine("/sys/class/dmi/id/product_name"); }
+};
+
+// =============================
+// SYSTEM FUNCTIONS
+// =============================
+std::string CheckSecureBoot();
+std::string getKernelInfo();
+std::string shell();
+std::string getPackageManager();
+double getRAMInfo(const std::string& arg);
+std::string BuildInfo();
+std::string getDistroInfo();
+std::string getBootMode();
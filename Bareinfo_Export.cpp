@@ -0,0 +1,318 @@
+#include "Bareinfo_Export.h"
+#include "Bareinfo_Fields.h"
+#include "Bareinfo_Hardware.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// =============================
+// EXPORT FUNCTIONS
+// =============================
+void ExportToHTML() {
+    std::ostringstream html;
+    html << "<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n<meta charset=\"UTF-8\">\n"
+         << "<title>bareinfo.json Viewer</title>\n<style>\n"
+         << "body{background:#1e1e1e;color:#dcdcdc;font-family:monospace;padding:20px;}"
+         << "h2,h3,h4,h5{color:#72bcd4;} .section{margin-bottom:20px;}"
+         << ".section .section{margin:0 0 8px 20px;} .section .section>:first-child{margin:4px 0;}"
+         << "</style>\n</head>\n<body>\n<h1>System Information</h1>\n<div id=\"output\"></div>\n"
+         // Nested objects (Pressure, _meta) get their own indented sub-section
+         << "<script>\nfunction displaySection(title,obj,depth=2){const s=document.createElement('div');"
+         << "s.className='section';const h=document.createElement('h'+Math.min(depth,5));"
+         << "h.textContent=title;s.appendChild(h);"
+         << "for(const k in obj){if(obj[k]!==null&&typeof obj[k]==='object'){"
+         << "s.appendChild(displaySection(k,obj[k],depth+1));continue;}const l=document.createElement('div');"
+         << "const v=typeof obj[k]==='string'?`\"${obj[k]}\"`:obj[k];"
+         << "l.textContent=`${k}: ${v}`;s.appendChild(l);}return s;}"
+         << "fetch('bareinfo.json').then(r=>r.json()).then(d=>{const o=document.getElementById('output');"
+         << "for(const s in d){o.appendChild(displaySection(s,d[s]));}})"
+         << ".catch(e=>document.getElementById('output').textContent='Error: '+e.message);"
+         << "</script>\n</body>\n</html>\n";
+
+    std::ofstream HTML("Bareinfo.html");
+    HTML << html.str();
+}
+
+// Escapes a value so it can be placed between quotes in JSON
+std::string jsonEscape(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+// "_meta": {"TotalMs": 1.2, "Collectors": {"cpu.model": {"WallMs": 0.1, ...}, ...}}
+static void appendMetaJSON(std::string& json, const std::vector<const Field*>& fields,
+                           const std::vector<FieldMeta>& meta, bool pretty) {
+    const char* nl      = pretty ? "\n" : "";
+    const char* indent1 = pretty ? "  " : "";
+    const char* indent2 = pretty ? "    " : "";
+    const char* indent3 = pretty ? "      " : "";
+    const char* colon   = pretty ? ": " : ":";
+    const char* comma   = pretty ? ", " : ",";
+
+    double total = 0;
+    for (const FieldMeta& m : meta) total += m.wallMs;
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "%s\"_meta\"%s{%s%s\"TotalMs\"%s%.3f,%s%s\"Collectors\"%s{%s",
+                  indent1, colon, nl, indent2, colon, total, nl, indent2, colon, nl);
+    json += buf;
+    for (size_t i = 0; i < fields.size() && i < meta.size(); ++i) {
+        const FieldMeta& m = meta[i];
+        std::snprintf(buf, sizeof(buf), "%s\"%s\"%s{\"WallMs\"%s%.3f%s\"BytesRead\"%s%llu%s\"FilesOpened\"%s%llu%s\"PathLookups\"%s%llu%s\"Cached\"%s%s}%s%s",
+                      indent3, fields[i]->name, colon, colon, m.wallMs, comma,
+                      colon, static_cast<unsigned long long>(m.bytesRead), comma,
+                      colon, static_cast<unsigned long long>(m.filesOpened), comma,
+                      colon, static_cast<unsigned long long>(m.pathLookups), comma,
+                      colon, m.cached ? "true" : "false", i + 1 < fields.size() ? "," : "", nl);
+        json += buf;
+    }
+    json += indent2;
+    json += "}";
+    json += nl;
+    json += indent1;
+    json += "}";
+    json += nl;
+}
+
+std::string formatJSON(const std::vector<const Field*>& fields,
+                       const std::vector<std::string>& values,
+                       bool pretty,
+                       const std::vector<FieldMeta>* meta) {
+    // NDJSON wants the same document on a single line
+    const char* nl      = pretty ? "\n" : "";
+    const char* indent1 = pretty ? "  " : "";
+    const char* indent2 = pretty ? "    " : "";
+    const char* colon   = pretty ? ": " : ":";
+
+    std::string json = "{";
+    json += nl;
+    const char* section = nullptr;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const Field* f = fields[i];
+        if (!f->jsonKey) continue;  // text only
+        if (!section || std::strcmp(section, f->section) != 0) {
+            if (section) {
+                json += nl;
+                json += indent1;
+                json += "},";
+                json += nl;
+            }
+            section = f->section;
+            json += indent1;
+            json += '"';
+            json += section;
+            json += '"';
+            json += colon;
+            json += "{";
+            json += nl;
+        } else {
+            json += ",";
+            json += nl;
+        }
+        json += indent2;
+        json += '"';
+        json += f->jsonKey;
+        json += '"';
+        json += colon;
+        if (f->flags & F_NUMERIC) {
+            json += values[i];
+        } else {
+            json += '"';
+            json += jsonEscape(values[i]);
+            json += '"';
+        }
+    }
+    if (section) {
+        json += nl;
+        json += indent1;
+        json += "}";
+        if (meta) json += ",";
+        json += nl;
+    }
+    if (meta) appendMetaJSON(json, fields, *meta, pretty);
+    json += "}\n";
+    return json;
+}
+
+void PrintNDJSON(bool meta) {
+    std::vector<const Field*> fields = allFields(Output::JSON);
+    std::vector<FieldMeta> costs;
+    std::vector<std::string> values = collectFields(fields, meta ? &costs : nullptr);
+    std::cout << formatJSON(fields, values, false, meta ? &costs : nullptr);
+}
+
+void ExportToFile(bool meta) {
+    std::vector<const Field*> fields = allFields(Output::Text);
+    std::vector<FieldMeta> costs;
+    std::vector<std::string> values = collectFields(fields, meta ? &costs : nullptr);
+    std::ofstream file("bareinfo.txt");
+    file << formatFields(fields, values, false, false);
+    if (meta) file << formatMeta(fields, costs, false);
+}
+
+void ExportToJSON(bool meta) {
+    std::vector<const Field*> fields = allFields(Output::JSON);
+    std::vector<FieldMeta> costs;
+    std::vector<std::string> values = collectFields(fields, meta ? &costs : nullptr);
+    std::ofstream jsonFile("bareinfo.json");
+    jsonFile << formatJSON(fields, values, true, meta ? &costs : nullptr);
+}
+
+void PrintSummary(bool meta) {
+    std::vector<const Field*> fields = allFields(Output::Text);
+    std::vector<FieldMeta> costs;
+    std::vector<std::string> values = collectFields(fields, meta ? &costs : nullptr);
+    std::cout << formatFields(fields, values, true, false);
+    if (meta) std::cout << formatMeta(fields, costs, true);
+}
+
+std::string formatHardwareJSON(const std::vector<MemoryModule>& modules,
+                               const std::string& memoryError,
+                               const std::vector<PCIDevice>& devices,
+                               bool pretty) {
+    // One module/device per line when pretty, so the file stays diffable
+    const char* nl     = pretty ? "\n" : "";
+    const char* indent = pretty ? "    " : "";
+    const char* colon  = pretty ? ": " : ":";
+
+    std::string json = "{";
+    json += nl;
+    if (modules.empty()) {
+        json += pretty ? "  " : "";
+        json += "\"MemoryModulesError\"";
+        json += colon;
+        json += "\"" + jsonEscape(memoryError) + "\",";
+        json += nl;
+    }
+    json += pretty ? "  " : "";
+    json += "\"MemoryModules\"";
+    json += colon;
+    json += "[";
+    json += nl;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        const MemoryModule& m = modules[i];
+        json += indent;
+        json += "{\"Locator\":\"" + jsonEscape(m.locator) + "\",\"Bank\":\"" + jsonEscape(m.bank) +
+                "\",\"Type\":\"" + jsonEscape(m.type) + "\",\"Manufacturer\":\"" + jsonEscape(m.manufacturer) +
+                "\",\"PartNumber\":\"" + jsonEscape(m.partNumber) + "\",\"SizeMB\":" + std::to_string(m.sizeMB) +
+                ",\"SpeedMTs\":" + std::to_string(m.speedMTs) + ",\"ConfiguredMTs\":" + std::to_string(m.configuredMTs) + "}";
+        if (i + 1 < modules.size()) json += ",";
+        json += nl;
+    }
+    json += pretty ? "  ]," : "],";
+    json += nl;
+
+    json += pretty ? "  " : "";
+    json += "\"PCIDevices\"";
+    json += colon;
+    json += "[";
+    json += nl;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        const PCIDevice& d = devices[i];
+        const char* cls = pciClassName(d.classCode);
+        const char* vendor = pciVendorName(d.vendor);
+        char ids[96];
+        std::snprintf(ids, sizeof(ids), "\"Vendor\":\"%04x\",\"Device\":\"%04x\",\"Class\":\"%06x\"",
+                      d.vendor, d.device, d.classCode);
+        json += indent;
+        json += "{\"Address\":\"" + jsonEscape(d.address) + "\"," + ids +
+                ",\"VendorName\":\"" + jsonEscape(vendor ? vendor : "Unknown") +
+                "\",\"ClassName\":\"" + jsonEscape(cls ? cls : "Unknown") +
+                "\",\"NumaNode\":" + std::to_string(d.numaNode) +
+                ",\"LinkSpeed\":\"" + jsonEscape(d.linkSpeed) + "\",\"LinkWidth\":\"" + jsonEscape(d.linkWidth) + "\"}";
+        if (i + 1 < devices.size()) json += ",";
+        json += nl;
+    }
+    json += pretty ? "  ]" : "]";
+    json += nl;
+    json += "}\n";
+    return json;
+}
+
+void PrintHardware(bool json, bool pretty) {
+    const std::string GREEN = "\033[32m";
+    const std::string RESET = "\033[0m";
+
+    std::string error;
+    std::vector<MemoryModule> modules = MemoryInfo().getModules(error);
+    if (json) {
+        std::cout << formatHardwareJSON(modules, error, PCIInfo().getDevices(), pretty);
+        return;
+    }
+
+    std::cout << GREEN << "Memory Modules:" << RESET << "\n";
+    if (modules.empty()) std::cout << "  N/A (" << error << ")\n";
+    for (const MemoryModule& m : modules) {
+        std::cout << "  " << std::left << std::setw(16) << m.locator;
+        if (m.sizeMB == 0) {
+            std::cout << "empty\n";
+            continue;
+        }
+        std::cout << formatMemorySize(m.sizeMB) << " " << m.type;
+        if (m.speedMTs) std::cout << " " << m.speedMTs << " MT/s";
+        if (m.configuredMTs && m.configuredMTs != m.speedMTs) std::cout << " (running at " << m.configuredMTs << ")";
+        if (!m.manufacturer.empty()) std::cout << " " << m.manufacturer;
+        if (!m.partNumber.empty()) std::cout << " " << m.partNumber;
+        std::cout << "\n";
+    }
+
+    std::vector<PCIDevice> devices = PCIInfo().getDevices();
+    std::cout << GREEN << "PCI Devices:" << RESET << "\n";
+    if (devices.empty()) std::cout << "  N/A\n";
+    for (const PCIDevice& d : devices) {
+        const char* cls = pciClassName(d.classCode);
+        const char* vendor = pciVendorName(d.vendor);
+        char ids[16];
+        std::snprintf(ids, sizeof(ids), "[%04x:%04x]", d.vendor, d.device);
+
+        std::cout << "  " << d.address << "  " << std::left << std::setw(18) << (cls ? cls : "Unknown")
+                  << std::setw(18) << (vendor ? vendor : "Unknown") << ids;
+        if (d.numaNode >= 0) std::cout << "  numa " << d.numaNode;
+        if (!d.linkSpeed.empty() && d.linkSpeed != "Unknown") std::cout << "  " << d.linkSpeed << " x" << d.linkWidth;
+        std::cout << "\n";
+    }
+}
+
+void PrintTuning(const TuningProfile& profile) {
+    const std::string RED    = "\033[31m";
+    const std::string YELLOW = "\033[33m";
+    const std::string RESET  = "\033[0m";
+
+    std::vector<TuningSetting> settings = TuningInfo().collect(profile);
+    size_t differs = 0;
+
+    std::cout << YELLOW << "Tuning (profile: " << profile.name << ")" << RESET << "\n";
+    for (const TuningSetting& s : settings) {
+        std::cout << "  " << std::left << std::setw(40) << s.key + " ";
+        if (s.differs) {
+            ++differs;
+            std::cout << RED << s.value << RESET << " (expected " << s.expected << ")";
+        } else {
+            std::cout << s.value;
+        }
+        std::cout << "\n";
+    }
+    std::cout << YELLOW << "Settings that differ: " << RESET << differs << "\n";
+}
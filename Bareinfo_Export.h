@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Bareinfo_Fields.h"
+#include "Bareinfo_Hardware.h"
+#include "Bareinfo_Tuning.h"
+
+// =============================
+// EXPORT FUNCTIONS
+// =============================
+void ExportToHTML();
+// With meta = true the outputs below also carry the _meta section (what
+// every collector cost: wall time, bytes read, files opened, stat lookups, cache hits)
+void ExportToFile(bool meta = false);
+void ExportToJSON(bool meta = false);
+
+// Prints the coloured summary to stdout
+void PrintSummary(bool meta = false);
+
+// Prints the snapshot as one NDJSON line to stdout
+void PrintNDJSON(bool meta = false);
+
+// Prints every memory module and PCI device, as a table or, with json set,
+// as a JSON document (pretty) or one NDJSON line
+void PrintHardware(bool json = false, bool pretty = true);
+
+// Prints the kernel tuning report, settings that differ from the profile are red
+void PrintTuning(const TuningProfile& profile);
+
+std::string jsonEscape(const std::string& value);
+
+// Formats the --hardware inventory as JSON: a MemoryModules and a PCIDevices
+// array, plus MemoryModulesError when the DMI table couldn't be read
+std::string formatHardwareJSON(const std::vector<MemoryModule>& modules,
+                               const std::string& memoryError,
+                               const std::vector<PCIDevice>& devices,
+                               bool pretty = true);
+
+// Formats the values as the bareinfo.json document, grouped by Field::section.
+// With pretty = false the document is a single NDJSON line. A non-null meta
+// adds the "_meta" section at the end.
+std::string formatJSON(const std::vector<const Field*>& fields,
+                       const std::vector<std::string>& values,
+                       bool pretty = true,
+                       const std::vector<FieldMeta>* meta = nullptr);
@@ -0,0 +1,228 @@
+#include "Bareinfo_Fields.h"
+#include "Bareinfo_Core.h"
+#include "Bareinfo_Hardware.h"
+#include "Bareinfo_Pressure.h"
+#include "Bareinfo_Tuning.h"
+
+#include <chrono>
+#include <cstdio>
+
+#define BLUE    "\033[34m"
+#define RED     "\033[31m"
+#define GREEN   "\033[32m"
+#define CYAN    "\033[36m"
+#define YELLOW  "\033[33m"
+#define MAGENTA "\033[35m"
+#define RESET   "\033[0m"
+
+// Order matters: it is the order of the default output and of the JSON sections
+static const Field fields[] = {
+    {"cpu.model", "CPU Model:          ", BLUE, "CPU", "Model", "", F_STABLE,
+     [] { return CPUInfo().getCPUName(); }},
+    {"cpu.cores", "CPU Cores:          ", BLUE, "CPU", "Cores", "", F_STABLE,
+     [] { return CPUInfo().getCPUCores(); }},
+    {"cpu.vendor", "CPU Vendor:         ", BLUE, "CPU", "Vendor", "", F_STABLE,
+     [] { return CPUInfo().getCPUVendor(); }},
+
+    {"bios.vendor", "BIOS/UEFI Vendor:   ", RED, "BIOS", "Vendor", "", F_STABLE,
+     [] { return BIOSInfo().getBIOSVendor(); }},
+    {"bios.version", "BIOS/UEFI Version:  ", RED, "BIOS", "Version", "", F_STABLE,
+     [] { return BIOSInfo().getBIOSVersion(); }},
+    {"bios.date", "BIOS/UEFI Date:     ", RED, "BIOS", "Date", "", F_STABLE,
+     [] { return BIOSInfo().getBIOSDate(); }},
+    {"bios.release", "BIOS/UEFI Release:  ", RED, "BIOS", "Release", "", F_STABLE,
+     [] { return BIOSInfo().getBIOSRelease(); }},
+
+    {"board.name", "Motherboard Name:   ", GREEN, "Motherboard", "Name", "", F_STABLE,
+     [] { return MotherboardInfo().getMotherboardName(); }},
+    {"board.vendor", "Motherboard Vendor: ", GREEN, "Motherboard", "Vendor", "", F_STABLE,
+     [] { return MotherboardInfo().getMotherboardVendor(); }},
+    {"board.system_vendor", "System Vendor:      ", CYAN, "Motherboard", "SystemVendor", "", F_STABLE,
+     [] { return MotherboardInfo().getSystemVendor(); }},
+    {"board.product_name", "Product Name:       ", CYAN, "Motherboard", "ProductName", "", F_STABLE,
+     [] { return MotherboardInfo().getProductName(); }},
+
+    {"kernel.release", "Kernel:             ", YELLOW, "System", "Kernel", "", F_STABLE, getKernelInfo},
+    {"system.shell", "Default Shell:      ", YELLOW, "System", "DefaultShell", "", F_STABLE, shell},
+    {"kernel.build", "Build Info:         ", YELLOW, "System", "BuildInfo", "", F_STABLE, BuildInfo},
+    {"system.boot_mode", "Boot Mode:          ", YELLOW, "System", "BootMode", "", F_STABLE, getBootMode},
+    {"system.package_manager", "Package Manager:    ", YELLOW, "System", "PackageManager", "", 0,
+     getPackageManager},
+
+    {"system.distro", "Distro name:        ", MAGENTA, "System", "Distro", "", F_STABLE, getDistroInfo},
+    {"system.secure_boot", "Secure Boot state:  ", MAGENTA, "System", "SecureBoot", "", F_STABLE,
+     CheckSecureBoot},
+    {"memory.total", "Total RAM:          ", MAGENTA, "System", "TotalRAM_GB", " GB", F_NUMERIC | F_STABLE,
+     [] { return formatNumber(getRAMInfo("RAM")); }},
+    {"memory.available", "Free RAM:           ", MAGENTA, "System", "FreeRAM_GB", " GB", F_NUMERIC,
+     [] { return formatNumber(getRAMInfo("FREE")); }},
+
+    {"memory.modules", "Memory Modules:     ", GREEN, "Hardware", "MemoryModules", "", F_STABLE,
+     [] { return MemoryInfo().getSummary(); }},
+    {"pci.devices", "PCI Devices:        ", GREEN, "Hardware", "PCIDevices", "", F_EXTENDED,
+     [] { return PCIInfo().getSummary(); }},
+
+    // One line per resource in the text outputs, the numbers as objects in JSON
+    {"psi.cpu", "CPU Pressure:       ", CYAN, "Pressure", nullptr, "", 0,
+     [] { return PressureInfo().getSummary("cpu"); }},
+    {"psi.memory", "Memory Pressure:    ", CYAN, "Pressure", nullptr, "", 0,
+     [] { return PressureInfo().getSummary("memory"); }},
+    {"psi.io", "IO Pressure:        ", CYAN, "Pressure", nullptr, "", 0,
+     [] { return PressureInfo().getSummary("io"); }},
+    {"psi.cpu.stats", nullptr, CYAN, "Pressure", "CPU", "", F_NUMERIC,
+     [] { return PressureInfo().getJSON("cpu"); }},
+    {"psi.memory.stats", nullptr, CYAN, "Pressure", "Memory", "", F_NUMERIC,
+     [] { return PressureInfo().getJSON("memory"); }},
+    {"psi.io.stats", nullptr, CYAN, "Pressure", "IO", "", F_NUMERIC,
+     [] { return PressureInfo().getJSON("io"); }},
+
+    {"tuning.differences", "Tuning Mismatches:  ", YELLOW, "Tuning", "Differences", "", F_EXTENDED,
+     [] { return TuningInfo().getSummary(); }},
+};
+
+const Field* fieldsBegin() { return fields; }
+const Field* fieldsEnd()   { return fields + sizeof(fields) / sizeof(fields[0]); }
+
+const Field* findField(const std::string& name) {
+    for (const Field* f = fieldsBegin(); f != fieldsEnd(); ++f) {
+        if (name == f->name) return f;
+    }
+    return nullptr;
+}
+
+bool parseFieldList(const std::string& spec, std::vector<const Field*>& out, std::string& bad) {
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t end = spec.find(',', pos);
+        if (end == std::string::npos) end = spec.size();
+        std::string name = spec.substr(pos, end - pos);
+        pos = end + 1;
+        if (name.empty()) continue;
+
+        const Field* f = findField(name);
+        if (!f) {
+            bad = name;
+            return false;
+        }
+        out.push_back(f);
+    }
+    return !out.empty();
+}
+
+std::vector<const Field*> allFields(Output output) {
+    std::vector<const Field*> all;
+    for (const Field* f = fieldsBegin(); f != fieldsEnd(); ++f) {
+        if ((f->flags & F_EXTENDED)) continue;
+        if (output == Output::Text ? !f->label : !f->jsonKey) continue;
+        all.push_back(f);
+    }
+    return all;
+}
+
+// Values of stable fields by registry index, filled once the cache is on
+static bool cacheEnabled = false;
+static std::string cachedValues[sizeof(fields) / sizeof(fields[0])];
+static bool cachedValid[sizeof(fields) / sizeof(fields[0])];
+
+void setFieldCache(bool enabled) {
+    cacheEnabled = enabled;
+    for (bool& valid : cachedValid) valid = false;
+}
+
+std::vector<std::string> collectFields(const std::vector<const Field*>& list, std::vector<FieldMeta>* meta) {
+    std::vector<std::string> values;
+    values.reserve(list.size());
+    if (meta) meta->assign(list.size(), FieldMeta());
+
+    for (size_t i = 0; i < list.size(); ++i) {
+        const Field* f = list[i];
+        size_t slot = static_cast<size_t>(f - fieldsBegin());
+        bool cacheable = cacheEnabled && (f->flags & F_STABLE);
+        if (cacheable && cachedValid[slot]) {
+            values.push_back(cachedValues[slot]);
+            if (meta) (*meta)[i].cached = true;
+            continue;
+        }
+
+        if (!meta) {
+            values.push_back(f->collect());
+        } else {
+            // Only pay for the clock when someone asked for _meta
+            IOCounters before = ioCounters();
+            auto start = std::chrono::steady_clock::now();
+            values.push_back(f->collect());
+            auto end = std::chrono::steady_clock::now();
+
+            FieldMeta& m = (*meta)[i];
+            m.wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+            m.bytesRead = ioCounters().bytesRead - before.bytesRead;
+            m.filesOpened = ioCounters().filesOpened - before.filesOpened;
+            m.pathLookups = ioCounters().pathLookups - before.pathLookups;
+        }
+
+        if (cacheable) {
+            cachedValues[slot] = values.back();
+            cachedValid[slot] = true;
+        }
+    }
+    return values;
+}
+
+std::string formatFields(const std::vector<const Field*>& list,
+                         const std::vector<std::string>& values,
+                         bool color, bool raw) {
+    std::string out;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (!raw) {
+            if (color) out += list[i]->color;
+            if (list[i]->label) {
+                out += list[i]->label;
+            } else {
+                // JSON only field asked for by name
+                char label[64];
+                std::snprintf(label, sizeof(label), "%-19s ", (std::string(list[i]->name) + ":").c_str());
+                out += label;
+            }
+            if (color) out += RESET;
+        }
+        out += values[i];
+        if (!raw) out += list[i]->unit;
+        out += '\n';
+    }
+    return out;
+}
+
+std::string formatMeta(const std::vector<const Field*>& list,
+                       const std::vector<FieldMeta>& meta, bool color) {
+    std::string out;
+    if (color) out += YELLOW;
+    out += "_meta:";
+    if (color) out += RESET;
+    out += '\n';
+
+    char line[160];
+    FieldMeta total;
+    for (size_t i = 0; i < list.size() && i < meta.size(); ++i) {
+        const FieldMeta& m = meta[i];
+        std::snprintf(line, sizeof(line), "  %-24s %9.3f ms %9llu B %4llu files %4llu lookups%s\n", list[i]->name,
+                      m.wallMs, static_cast<unsigned long long>(m.bytesRead),
+                      static_cast<unsigned long long>(m.filesOpened), static_cast<unsigned long long>(m.pathLookups),
+                      m.cached ? "  (cached)" : "");
+        out += line;
+        total.wallMs += m.wallMs;
+        total.bytesRead += m.bytesRead;
+        total.filesOpened += m.filesOpened;
+        total.pathLookups += m.pathLookups;
+    }
+    std::snprintf(line, sizeof(line), "  %-24s %9.3f ms %9llu B %4llu files %4llu lookups\n", "total", total.wallMs,
+                  static_cast<unsigned long long>(total.bytesRead), static_cast<unsigned long long>(total.filesOpened),
+                  static_cast<unsigned long long>(total.pathLookups));
+    out += line;
+    return out;
+}
+
+std::string formatNumber(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%g", value);
+    return buf;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =============================
+// FIELD REGISTRY
+// =============================
+// Every value Bareinfo can print is described by one Field. The outputs walk
+// the registry, and --fields only runs the collectors of the fields asked for.
+enum FieldFlags : unsigned {
+    F_NUMERIC  = 1 << 0,  // written without quotes in JSON (numbers, objects)
+    F_STABLE   = 1 << 1,  // can't change while we run (DMI, kernel, ...)
+    F_EXTENDED = 1 << 2,  // scans a whole sysfs tree, only collected when asked for by name
+};
+
+struct Field {
+    const char* name;     // query name, e.g. "memory.available"
+    const char* label;    // label in the coloured/text output, nullptr: JSON only
+    const char* color;    // ANSI colour of the label
+    const char* section;  // JSON section
+    const char* jsonKey;  // key inside the JSON section, nullptr: text only
+    const char* unit;     // appended in the text output, "" for none
+    unsigned flags;       // FieldFlags, 0 for none
+    std::string (*collect)();
+};
+
+const Field* fieldsBegin();
+const Field* fieldsEnd();
+const Field* findField(const std::string& name);
+
+// Parses a comma separated list of field names, on failure bad holds the
+// name that isn't in the registry
+bool parseFieldList(const std::string& spec, std::vector<const Field*>& out, std::string& bad);
+
+enum class Output { Text, JSON };
+
+// The default set for the summary and the exports: no extended fields, and
+// only the fields that output shows (a label for text, a jsonKey for JSON)
+std::vector<const Field*> allFields(Output output);
+
+// What one collector cost, for the _meta output
+struct FieldMeta {
+    double wallMs = 0;
+    uint64_t bytesRead = 0;
+    uint64_t filesOpened = 0;
+    uint64_t pathLookups = 0;
+    bool cached = false;  // value reused from an earlier pass, nothing was read
+};
+
+// Long running modes (--watch) turn this on so that stable fields are only
+// collected on the first pass
+void setFieldCache(bool enabled);
+
+// Runs the collectors of the given fields, values[i] belongs to fields[i].
+// If meta isn't null, (*meta)[i] gets the cost of collecting values[i].
+std::vector<std::string> collectFields(const std::vector<const Field*>& fields,
+                                       std::vector<FieldMeta>* meta = nullptr);
+
+// Formats the collected values, raw prints one bare value per line
+std::string formatFields(const std::vector<const Field*>& fields,
+                         const std::vector<std::string>& values,
+                         bool color, bool raw);
+
+// Formats the _meta table for the text output, one collector per line
+std::string formatMeta(const std::vector<const Field*>& fields,
+                       const std::vector<FieldMeta>& meta, bool color);
+
+// Formats a double the way the stream output always did ("%g")
+std::string formatNumber(double value);
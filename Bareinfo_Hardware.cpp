@@ -0,0 +1,345 @@
+#include "Bareinfo_Hardware.h"
+#include "Bareinfo_Core.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+// =============================
+// MEMORY MODULES (DMI TYPE 17)
+// =============================
+
+// Offsets inside an SMBIOS type 17 (Memory Device) structure
+namespace {
+constexpr size_t kDmiBankLocator   = 0x11;
+constexpr size_t kDmiDeviceLocator = 0x10;
+constexpr size_t kDmiSize          = 0x0C;
+constexpr size_t kDmiMemoryType    = 0x12;
+constexpr size_t kDmiSpeed         = 0x15;
+constexpr size_t kDmiManufacturer  = 0x17;
+constexpr size_t kDmiPartNumber    = 0x1A;
+constexpr size_t kDmiExtendedSize  = 0x1C;
+constexpr size_t kDmiConfigSpeed   = 0x20;
+constexpr size_t kDmiExtSpeed      = 0x54;
+constexpr size_t kDmiExtConfSpeed  = 0x58;
+
+unsigned word(const std::string& t, size_t off) {
+    return static_cast<unsigned char>(t[off]) | (static_cast<unsigned char>(t[off + 1]) << 8);
+}
+
+uint32_t dword(const std::string& t, size_t off) {
+    return word(t, off) | (static_cast<uint32_t>(word(t, off + 2)) << 16);
+}
+
+// String n (1 based) from the string set that follows the formatted area
+std::string dmiString(const std::string& t, size_t strings, size_t end, unsigned n) {
+    if (n == 0) return "";
+    size_t pos = strings;
+    while (pos < end && --n > 0) {
+        pos = t.find('\0', pos);
+        if (pos == std::string::npos || pos >= end) return "";
+        ++pos;
+    }
+    if (pos >= end) return "";
+    std::string s = t.substr(pos, t.find('\0', pos) - pos);
+    while (!s.empty() && s.back() == ' ') s.pop_back();
+    return s;
+}
+
+const char* dmiMemoryType(unsigned type) {
+    switch (type) {
+        case 0x0F: return "SDRAM";
+        case 0x12: return "DDR";
+        case 0x13: return "DDR2";
+        case 0x14: return "DDR2 FB-DIMM";
+        case 0x18: return "DDR3";
+        case 0x1A: return "DDR4";
+        case 0x1B: return "LPDDR";
+        case 0x1C: return "LPDDR2";
+        case 0x1D: return "LPDDR3";
+        case 0x1E: return "LPDDR4";
+        case 0x1F: return "Logical non-volatile";
+        case 0x20: return "HBM";
+        case 0x21: return "HBM2";
+        case 0x22: return "DDR5";
+        case 0x23: return "LPDDR5";
+        case 0x24: return "HBM3";
+        default:   return "Unknown";
+    }
+}
+} // namespace
+
+std::vector<MemoryModule> parseDMIMemoryDevices(const std::string& t) {
+    std::vector<MemoryModule> modules;
+    size_t off = 0;
+
+    while (off + 4 <= t.size()) {
+        unsigned type = static_cast<unsigned char>(t[off]);
+        size_t len = static_cast<unsigned char>(t[off + 1]);
+        if (len < 4 || off + len > t.size()) break;
+
+        // The string set ends with two NUL bytes
+        size_t strings = off + len;
+        size_t end = strings;
+        while (end + 1 < t.size() && !(t[end] == '\0' && t[end + 1] == '\0')) ++end;
+
+        if (type == 17 && len > kDmiMemoryType) {
+            MemoryModule m;
+            m.locator = dmiString(t, strings, end, static_cast<unsigned char>(t[off + kDmiDeviceLocator]));
+            m.bank    = dmiString(t, strings, end, static_cast<unsigned char>(t[off + kDmiBankLocator]));
+            m.type    = dmiMemoryType(static_cast<unsigned char>(t[off + kDmiMemoryType]));
+
+            // 0 = empty slot, 0xFFFF = unknown, 0x7FFF = look at the extended size,
+            // bit 15 set = the value is in KB instead of MB
+            unsigned size = word(t, off + kDmiSize);
+            if (size == 0x7FFF && len >= kDmiExtendedSize + 4) {
+                m.sizeMB = dword(t, off + kDmiExtendedSize) & 0x7FFFFFFF;
+            } else if (size != 0xFFFF) {
+                m.sizeMB = (size & 0x8000) ? ((size & 0x7FFF) + 1023) / 1024 : size;
+            }
+
+            if (len >= kDmiSpeed + 2) {
+                m.speedMTs = word(t, off + kDmiSpeed);
+                if (m.speedMTs == 0xFFFF && len >= kDmiExtSpeed + 4) m.speedMTs = dword(t, off + kDmiExtSpeed);
+            }
+            if (len >= kDmiConfigSpeed + 2) {
+                m.configuredMTs = word(t, off + kDmiConfigSpeed);
+                if (m.configuredMTs == 0xFFFF && len >= kDmiExtConfSpeed + 4) m.configuredMTs = dword(t, off + kDmiExtConfSpeed);
+            }
+            if (len > kDmiPartNumber) {
+                m.manufacturer = dmiString(t, strings, end, static_cast<unsigned char>(t[off + kDmiManufacturer]));
+                m.partNumber   = dmiString(t, strings, end, static_cast<unsigned char>(t[off + kDmiPartNumber]));
+            }
+            modules.push_back(m);
+        }
+
+        if (type == 127) break; // end of table
+        off = end + 2;
+    }
+    return modules;
+}
+
+std::vector<MemoryModule> MemoryInfo::getModules(std::string& error) {
+    std::string table;
+    if (!readFile("/sys/firmware/dmi/tables/DMI", table)) {
+        error = (errno == EACCES || errno == EPERM) ? "DMI table needs root" : "No DMI table";
+        return {};
+    }
+
+    std::vector<MemoryModule> modules = parseDMIMemoryDevices(table);
+    if (modules.empty()) error = "No memory devices in DMI table";
+    return modules;
+}
+
+std::string formatMemorySize(uint64_t mb) {
+    char buf[32];
+    if (mb < 1024) std::snprintf(buf, sizeof(buf), "%llu MB", static_cast<unsigned long long>(mb));
+    else std::snprintf(buf, sizeof(buf), "%g GB", static_cast<double>(mb) / 1024);
+    return buf;
+}
+
+std::string MemoryInfo::getSummary() {
+    std::string error;
+    std::vector<MemoryModule> modules = getModules(error);
+    if (modules.empty()) return "N/A (" + error + ")";
+
+    size_t populated = 0;
+    uint64_t totalMB = 0;
+    const MemoryModule* first = nullptr;
+    for (const MemoryModule& m : modules) {
+        if (m.sizeMB == 0) continue;
+        ++populated;
+        totalMB += m.sizeMB;
+        if (!first) first = &m;
+    }
+
+    char buf[128];
+    if (!first) {
+        std::snprintf(buf, sizeof(buf), "0/%zu slots populated", modules.size());
+        return buf;
+    }
+
+    unsigned speed = first->configuredMTs ? first->configuredMTs : first->speedMTs;
+    std::snprintf(buf, sizeof(buf), "%zu/%zu slots, %s %s", populated, modules.size(),
+                  formatMemorySize(totalMB).c_str(), first->type.c_str());
+    std::string summary = buf;
+    if (speed) summary += " " + std::to_string(speed) + " MT/s";
+    return summary;
+}
+
+// =============================
+// PCI DEVICES
+// =============================
+namespace {
+struct PCIName {
+    uint32_t id;
+    const char* name;
+};
+
+// Sorts the name tables at compile time so lookups can binary search them
+template <size_t N>
+constexpr std::array<PCIName, N> sortById(std::array<PCIName, N> a) {
+    for (size_t i = 1; i < N; ++i) {
+        PCIName key = a[i];
+        size_t j = i;
+        while (j > 0 && a[j - 1].id > key.id) {
+            a[j] = a[j - 1];
+            --j;
+        }
+        a[j] = key;
+    }
+    return a;
+}
+
+template <size_t N>
+constexpr bool uniqueIds(const std::array<PCIName, N>& a) {
+    for (size_t i = 1; i < N; ++i) {
+        if (a[i - 1].id == a[i].id) return false;
+    }
+    return true;
+}
+
+constexpr auto pciVendors = sortById(std::array<PCIName, 53>{{
+    {0x8086, "Intel"},       {0x1022, "AMD"},          {0x1002, "AMD/ATI"},
+    {0x10de, "NVIDIA"},      {0x15b3, "Mellanox"},     {0x14e4, "Broadcom"},
+    {0x1000, "Broadcom/LSI"},{0x1077, "QLogic"},       {0x9005, "Adaptec"},
+    {0x144d, "Samsung"},     {0x1c5c, "SK hynix"},     {0x15b7, "Sandisk"},
+    {0x1987, "Phison"},      {0x126f, "Silicon Motion"},{0x1b4b, "Marvell"},
+    {0x11ab, "Marvell"},     {0x10ec, "Realtek"},      {0x168c, "Qualcomm Atheros"},
+    {0x17cb, "Qualcomm"},    {0x1af4, "Red Hat (virtio)"},{0x1b36, "Red Hat (QEMU)"},
+    {0x1234, "QEMU"},        {0x15ad, "VMware"},       {0x1414, "Microsoft"},
+    {0x1d0f, "Amazon"},      {0x1ae0, "Google"},       {0x19e5, "Huawei"},
+    {0x1924, "Solarflare"},  {0x1dd8, "Pensando"},     {0x1e0f, "KIOXIA"},
+    {0x1179, "Toshiba"},     {0x1bb1, "Seagate"},      {0x2646, "Kingston"},
+    {0x1da3, "Habana Labs"}, {0x1e52, "Tenstorrent"},  {0x102b, "Matrox"},
+    {0x1a03, "ASPEED"},      {0x10df, "Emulex"},       {0x19a2, "Emulex"},
+    {0x1425, "Chelsio"},     {0x1137, "Cisco"},        {0x1590, "HPE"},
+    {0x103c, "HP"},          {0x1028, "Dell"},         {0x1344, "Micron"},
+    {0x106b, "Apple"},       {0x13b5, "ARM"},          {0x1def, "Ampere"},
+    {0x10b5, "PLX"},         {0x1d94, "Hygon"},        {0x1d17, "Zhaoxin"},
+    {0x1cc1, "ADATA"},       {0x1e49, "YMTC"},
+}});
+static_assert(uniqueIds(pciVendors), "duplicate PCI vendor id");
+
+// Keyed by class << 8 | subclass
+constexpr auto pciClasses = sortById(std::array<PCIName, 37>{{
+    {0x0100, "SCSI"},             {0x0101, "IDE"},              {0x0104, "RAID"},
+    {0x0105, "ATA"},              {0x0106, "SATA"},             {0x0107, "SAS"},
+    {0x0108, "NVMe"},             {0x0180, "Storage"},          {0x0200, "Ethernet"},
+    {0x0207, "InfiniBand"},       {0x0208, "Fabric"},           {0x0280, "Network"},
+    {0x0300, "VGA"},              {0x0302, "3D controller"},    {0x0380, "Display"},
+    {0x0401, "Audio"},            {0x0403, "HD Audio"},         {0x0500, "RAM"},
+    {0x0600, "Host bridge"},      {0x0601, "ISA bridge"},       {0x0604, "PCI bridge"},
+    {0x0680, "Bridge"},           {0x0700, "Serial"},           {0x0780, "Communication"},
+    {0x0800, "PIC"},              {0x0805, "SD host"},          {0x0806, "IOMMU"},
+    {0x0880, "System peripheral"},{0x0b40, "Co-processor"},     {0x0c03, "USB"},
+    {0x0c04, "Fibre Channel"},    {0x0c05, "SMBus"},            {0x0c80, "Serial bus"},
+    {0x1080, "Encryption"},       {0x1101, "Perf counters"},    {0x1200, "Accelerator"},
+    {0x1300, "Instrumentation"},
+}});
+static_assert(uniqueIds(pciClasses), "duplicate PCI class id");
+
+// Indexed by the base class byte
+constexpr const char* pciBaseClasses[] = {
+    "Unclassified", "Storage", "Network", "Display", "Multimedia", "Memory",
+    "Bridge", "Communication", "System peripheral", "Input", "Docking station",
+    "Processor", "Serial bus", "Wireless", "Intelligent controller", "Satellite",
+    "Encryption", "Signal processing", "Accelerator", "Instrumentation",
+};
+
+template <size_t N>
+const char* lookup(const std::array<PCIName, N>& table, uint32_t id) {
+    auto it = std::lower_bound(table.begin(), table.end(), id,
+                               [](const PCIName& n, uint32_t v) { return n.id < v; });
+    return (it != table.end() && it->id == id) ? it->name : nullptr;
+}
+
+uint32_t parseHex(const FileRead& f) {
+    return f.ok ? static_cast<uint32_t>(std::strtoul(f.data.c_str(), nullptr, 16)) : 0;
+}
+
+std::string firstLine(const FileRead& f) {
+    return f.ok ? f.data.substr(0, f.data.find('\n')) : "";
+}
+
+const char* PCI_DEVICES = "/sys/bus/pci/devices/";
+} // namespace
+
+const char* pciVendorName(uint16_t vendor) {
+    return lookup(pciVendors, vendor);
+}
+
+const char* pciClassName(uint32_t classCode) {
+    if (const char* name = lookup(pciClasses, classCode >> 8)) return name;
+    uint32_t base = classCode >> 16;
+    return base < sizeof(pciBaseClasses) / sizeof(pciBaseClasses[0]) ? pciBaseClasses[base] : nullptr;
+}
+
+std::vector<PCIDevice> PCIInfo::getDevices() {
+    static const char* const attrs[] = {
+        "vendor", "device", "class", "numa_node", "current_link_speed", "current_link_width",
+    };
+    constexpr size_t N = sizeof(attrs) / sizeof(attrs[0]);
+
+    // All attributes of all devices go through one batched read
+    std::vector<std::string> addresses = listDirectory(PCI_DEVICES);
+    std::vector<FileRead> reads;
+    reads.reserve(addresses.size() * N);
+    for (const std::string& address : addresses) {
+        for (const char* attr : attrs) reads.push_back({PCI_DEVICES + address + "/" + attr, "", false});
+    }
+    readFiles(reads);
+
+    std::vector<PCIDevice> devices;
+    devices.reserve(addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        const FileRead* r = &reads[i * N];
+        PCIDevice d;
+        d.address   = addresses[i];
+        d.vendor    = static_cast<uint16_t>(parseHex(r[0]));
+        d.device    = static_cast<uint16_t>(parseHex(r[1]));
+        d.classCode = parseHex(r[2]);
+        if (r[3].ok) d.numaNode = std::atoi(r[3].data.c_str());
+        // Only PCIe functions have link attributes
+        d.linkSpeed = firstLine(r[4]);
+        d.linkWidth = firstLine(r[5]);
+        devices.push_back(d);
+    }
+    return devices;
+}
+
+std::string PCIInfo::getSummary() {
+    std::vector<std::string> addresses = listDirectory(PCI_DEVICES);
+    if (addresses.empty()) return "N/A";
+
+    std::vector<FileRead> reads;
+    reads.reserve(addresses.size());
+    for (const std::string& address : addresses) reads.push_back({PCI_DEVICES + address + "/class", "", false});
+    readFiles(reads);
+
+    size_t gpu = 0, nic = 0, nvme = 0, accel = 0;
+    for (const FileRead& r : reads) {
+        uint32_t cls = parseHex(r);
+        uint32_t base = cls >> 16;
+        if (base == 0x03) ++gpu;
+        else if (base == 0x02) ++nic;
+        else if ((cls >> 8) == 0x0108) ++nvme;
+        else if (base == 0x12 || (cls >> 8) == 0x0b40) ++accel;
+    }
+
+    std::string summary = std::to_string(addresses.size()) + " devices";
+    std::string parts;
+    auto add = [&parts](size_t n, const char* what) {
+        if (!n) return;
+        if (!parts.empty()) parts += ", ";
+        parts += std::to_string(n) + " " + what;
+    };
+    add(gpu, "GPU");
+    add(nic, "NIC");
+    add(nvme, "NVMe");
+    add(accel, "accelerator");
+    if (!parts.empty()) summary += " (" + parts + ")";
+    return summary;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =============================
+// MEMORY MODULES (DMI TYPE 17)
+// =============================
+struct MemoryModule {
+    std::string locator;       // slot, e.g. "DIMM_A1"
+    std::string bank;
+    std::string type;          // "DDR4", "DDR5", ...
+    std::string manufacturer;
+    std::string partNumber;
+    uint64_t sizeMB = 0;       // 0 means the slot is empty
+    unsigned speedMTs = 0;     // rated speed
+    unsigned configuredMTs = 0;
+};
+
+// "512 MB" below 1 GB, otherwise "32 GB" (or "1.5 GB")
+std::string formatMemorySize(uint64_t mb);
+
+// Parses the memory device structures out of a raw SMBIOS structure table
+std::vector<MemoryModule> parseDMIMemoryDevices(const std::string& table);
+
+class MemoryInfo {
+public:
+    // Reads /sys/firmware/dmi/tables/DMI, which is usually root only. On
+    // failure error says why and the vector is empty.
+    std::vector<MemoryModule> getModules(std::string& error);
+
+    // "2/4 slots, 32 GB DDR4 3200 MT/s" or "N/A (...)"
+    std::string getSummary();
+};
+
+// =============================
+// PCI DEVICES
+// =============================
+struct PCIDevice {
+    std::string address;       // "0000:00:02.0"
+    uint16_t vendor = 0;
+    uint16_t device = 0;
+    uint32_t classCode = 0;    // 24 bit class/subclass/prog-if
+    int numaNode = -1;
+    std::string linkSpeed;     // "8.0 GT/s PCIe", "" if not a PCIe link
+    std::string linkWidth;
+};
+
+// Names from the compiled in tables, nullptr if the id isn't known
+const char* pciVendorName(uint16_t vendor);
+const char* pciClassName(uint32_t classCode);
+
+class PCIInfo {
+public:
+    std::vector<PCIDevice> getDevices();
+
+    // "42 devices (2 GPU, 4 NIC, 3 NVMe)", only reads the class files
+    std::string getSummary();
+};
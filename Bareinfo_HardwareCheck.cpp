@@ -0,0 +1,186 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Bareinfo_Hardware.h"
+
+// Regression checks for the SMBIOS type 17 parser, run by ctest. The real
+// table needs root and doesn't exist in most VMs, so every case builds a
+// synthetic table and compares what parseDMIMemoryDevices makes of it.
+
+namespace {
+int failures = 0;
+
+// One type 17 structure, strings are numbered 1..4 in this order
+struct Dimm {
+    unsigned size = 0;         // 0x0C, MB unless bit 15 is set
+    uint32_t extendedSize = 0; // 0x1C, used when size is 0x7FFF
+    unsigned type = 0x02;      // 0x12, 0x02 = Unknown
+    unsigned speed = 0;        // 0x15
+    unsigned configured = 0;   // 0x20
+    uint32_t extendedSpeed = 0;
+    uint32_t extendedConfigured = 0;
+    std::vector<std::string> strings;  // locator, bank, manufacturer, part number
+    bool terminated = true;            // ends with the double NUL
+};
+
+void putWord(std::string& t, size_t off, unsigned v) {
+    t[off] = static_cast<char>(v & 0xFF);
+    t[off + 1] = static_cast<char>((v >> 8) & 0xFF);
+}
+
+void putDword(std::string& t, size_t off, uint32_t v) {
+    putWord(t, off, v & 0xFFFF);
+    putWord(t, off + 2, v >> 16);
+}
+
+// SMBIOS 3.7 length, long enough for the extended speeds
+std::string type17(const Dimm& d) {
+    std::string t(0x5C, '\0');
+    t[0] = 17;
+    t[1] = 0x5C;
+    putWord(t, 0x0C, d.size);
+    t[0x10] = d.strings.size() > 0 ? 1 : 0;
+    t[0x11] = d.strings.size() > 1 ? 2 : 0;
+    t[0x12] = static_cast<char>(d.type);
+    putWord(t, 0x15, d.speed);
+    t[0x17] = d.strings.size() > 2 ? 3 : 0;
+    t[0x1A] = d.strings.size() > 3 ? 4 : 0;
+    putDword(t, 0x1C, d.extendedSize);
+    putWord(t, 0x20, d.configured);
+    putDword(t, 0x54, d.extendedSpeed);
+    putDword(t, 0x58, d.extendedConfigured);
+
+    for (const std::string& s : d.strings) t += s + '\0';
+    if (d.strings.empty()) t += '\0';
+    if (d.terminated) t += '\0';
+    else t.pop_back();
+    return t;
+}
+
+// Anything that isn't type 17, the parser has to step over it
+std::string other(unsigned type, const std::string& text) {
+    std::string t(4, '\0');
+    t[0] = static_cast<char>(type);
+    t[1] = 4;
+    t += text.empty() ? std::string(2, '\0') : text + std::string(2, '\0');
+    return t;
+}
+
+std::string describe(const MemoryModule& m) {
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "[%s|%s|%s|%s|%s|%lluMB|%u|%u]", m.locator.c_str(), m.bank.c_str(),
+                  m.type.c_str(), m.manufacturer.c_str(), m.partNumber.c_str(),
+                  static_cast<unsigned long long>(m.sizeMB), m.speedMTs, m.configuredMTs);
+    return buf;
+}
+
+void check(const char* name, const std::string& table, const std::vector<MemoryModule>& expected) {
+    std::vector<MemoryModule> modules = parseDMIMemoryDevices(table);
+    bool ok = modules.size() == expected.size();
+    for (size_t i = 0; ok && i < expected.size(); ++i) ok = describe(modules[i]) == describe(expected[i]);
+
+    if (ok) {
+        std::printf("ok   %s\n", name);
+        return;
+    }
+    ++failures;
+    std::printf("FAIL %s:\n  got     ", name);
+    for (const MemoryModule& m : modules) std::printf(" %s", describe(m).c_str());
+    std::printf("\n  expected");
+    for (const MemoryModule& m : expected) std::printf(" %s", describe(m).c_str());
+    std::printf("\n");
+}
+
+void checkSize(uint64_t mb, const char* expected) {
+    std::string got = formatMemorySize(mb);
+    if (got == expected) {
+        std::printf("ok   formatMemorySize(%llu)\n", static_cast<unsigned long long>(mb));
+        return;
+    }
+    ++failures;
+    std::printf("FAIL formatMemorySize(%llu): got \"%s\", expected \"%s\"\n",
+                static_cast<unsigned long long>(mb), got.c_str(), expected);
+}
+
+MemoryModule module(const char* locator, const char* bank, const char* type, const char* manufacturer,
+                    const char* part, uint64_t sizeMB, unsigned speed, unsigned configured) {
+    MemoryModule m;
+    m.locator = locator;
+    m.bank = bank;
+    m.type = type;
+    m.manufacturer = manufacturer;
+    m.partNumber = part;
+    m.sizeMB = sizeMB;
+    m.speedMTs = speed;
+    m.configuredMTs = configured;
+    return m;
+}
+} // namespace
+
+int main() {
+    Dimm ddr5;
+    ddr5.size = 16384;  // 32 GB and up only fit in the extended size
+    ddr5.type = 0x22;
+    ddr5.speed = 5600;
+    ddr5.configured = 4800;
+    ddr5.strings = {"DIMM_A1", "BANK 0", "Samsung", "M321R2GA3BB6-CQK   "};
+    MemoryModule ddr5Module = module("DIMM_A1", "BANK 0", "DDR5", "Samsung", "M321R2GA3BB6-CQK", 16384, 5600, 4800);
+
+    Dimm empty;
+    empty.type = 0x02;
+    empty.strings = {"DIMM_A2", "BANK 1", "NO DIMM", "NO DIMM"};
+    MemoryModule emptyModule = module("DIMM_A2", "BANK 1", "Unknown", "NO DIMM", "NO DIMM", 0, 0, 0);
+
+    const std::string end = other(127, "");
+
+    check("populated DDR5 slot", other(0, "BIOS vendor") + type17(ddr5) + end, {ddr5Module});
+    check("empty slot", type17(ddr5) + type17(empty) + end, {ddr5Module, emptyModule});
+
+    Dimm big = ddr5;
+    big.size = 0x7FFF;
+    big.extendedSize = 262144;
+    check("extended size", type17(big) + end,
+          {module("DIMM_A1", "BANK 0", "DDR5", "Samsung", "M321R2GA3BB6-CQK", 262144, 5600, 4800)});
+
+    Dimm kb = ddr5;
+    kb.size = 0x8000 | 512;
+    kb.type = 0x0F;
+    check("size in KB", type17(kb) + end,
+          {module("DIMM_A1", "BANK 0", "SDRAM", "Samsung", "M321R2GA3BB6-CQK", 1, 5600, 4800)});
+
+    Dimm fast = ddr5;
+    fast.speed = 0xFFFF;
+    fast.extendedSpeed = 70000;
+    fast.configured = 0xFFFF;
+    fast.extendedConfigured = 68000;
+    check("extended speed", type17(fast) + end,
+          {module("DIMM_A1", "BANK 0", "DDR5", "Samsung", "M321R2GA3BB6-CQK", 16384, 70000, 68000)});
+
+    Dimm unknown = ddr5;
+    unknown.size = 0xFFFF;
+    unknown.strings.clear();
+    check("unknown size, no strings", type17(unknown) + end, {module("", "", "DDR5", "", "", 0, 5600, 4800)});
+
+    // The last string set runs into the end of the table
+    Dimm open = ddr5;
+    open.terminated = false;
+    check("missing double NUL", type17(ddr5) + type17(open), {ddr5Module, ddr5Module});
+
+    std::string second = type17(empty);
+    check("truncated in the formatted area", type17(ddr5) + second.substr(0, 0x20), {ddr5Module});
+    check("truncated header", type17(ddr5) + second.substr(0, 3), {ddr5Module});
+    check("empty table", "", {});
+
+    // Nothing after the end of table structure is looked at
+    check("end of table", type17(ddr5) + end + type17(empty), {ddr5Module});
+
+    checkSize(512, "512 MB");
+    checkSize(1023, "1023 MB");
+    checkSize(1024, "1 GB");
+    checkSize(1536, "1.5 GB");
+    checkSize(262144, "256 GB");
+
+    std::printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,317 @@
+#include "Bareinfo_IO.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef BAREINFO_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+// Smaller batches aren't worth the extra submissions
+constexpr size_t URING_MIN_FILES = 32;
+
+// sysfs attributes are never bigger than a page, anything longer
+// (/proc/cpuinfo and friends) is read again or finished with pread
+constexpr size_t FIRST_READ = 4096;
+
+// Opt in, see Bareinfo_IO.h
+bool uringRequested() {
+    static const bool requested = [] {
+        const char* env = getenv("BAREINFO_IO");
+        return env && std::strcmp(env, "uring") == 0;
+    }();
+    return requested;
+}
+
+// Reads the rest of a file after the first FIRST_READ bytes
+bool finishRead(int fd, std::string& data) {
+    char buf[4096];
+    for (;;) {
+        ssize_t n = ::pread(fd, buf, sizeof(buf), static_cast<off_t>(data.size()));
+        if (n < 0) return false;
+        if (n == 0) return true;
+        data.append(buf, static_cast<size_t>(n));
+    }
+}
+
+#ifdef BAREINFO_HAVE_IO_URING
+// Minimal io_uring wrapper on the raw syscalls, so there is no liburing
+// dependency and the static build keeps working
+class Ring {
+public:
+    // Every file takes three entries (open, read, close)
+    static constexpr unsigned ENTRIES = 768;
+    static constexpr unsigned SLOTS = ENTRIES / 3;
+
+    bool init() {
+        io_uring_params p;
+        // We are the only submitter and always wait for completions, which
+        // lets 6.1+ kernels skip the task_work IPIs. Older ones reject the
+        // flags, so retry without them.
+        for (unsigned flags : {IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN, 0u}) {
+            std::memset(&p, 0, sizeof(p));
+            p.flags = flags;
+            fd = static_cast<int>(::syscall(__NR_io_uring_setup, ENTRIES, &p));
+            if (fd >= 0) break;
+        }
+        if (fd < 0) return false;
+
+        sqSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqSize = cqSize = (sqSize > cqSize ? sqSize : cqSize);
+
+        sqPtr = ::mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqPtr == MAP_FAILED) return false;
+        cqPtr = single ? sqPtr
+                       : ::mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqPtr == MAP_FAILED) return false;
+        sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+        void* s = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (s == MAP_FAILED) return false;
+        sqes = static_cast<io_uring_sqe*>(s);
+
+        char* sq = static_cast<char*>(sqPtr);
+        char* cq = static_cast<char*>(cqPtr);
+        sqTail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask  = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cqHead  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask  = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        entries = p.sq_entries;
+
+        return supportsOps() && registerSlots();
+    }
+
+    ~Ring() {
+        // Requests of a broken ring may still be running, leave it to exit
+        if (broken) return;
+        if (sqes) ::munmap(sqes, sqesSize);
+        if (cqPtr && cqPtr != MAP_FAILED && cqPtr != sqPtr) ::munmap(cqPtr, cqSize);
+        if (sqPtr && sqPtr != MAP_FAILED) ::munmap(sqPtr, sqSize);
+        if (fd >= 0) ::close(fd);
+    }
+
+    // Files per submission
+    unsigned capacity() const { return entries / 3 < SLOTS ? entries / 3 : SLOTS; }
+
+    // Set when a submission failed half way, the ring state can't be trusted after that
+    bool broken = false;
+
+    // After a failed run() the kernel may still be reading into the buffers
+    // of that batch, so they are never freed
+    void abandon(std::string&& buffer) {
+        static auto* graveyard = new std::vector<std::string>;
+        graveyard->push_back(std::move(buffer));
+    }
+
+    // Queues one request, the caller never queues more than capacity()
+    io_uring_sqe* next(__u8 opcode, __u64 userData) {
+        unsigned tail = *sqTail + pending;
+        unsigned idx = tail & sqMask;
+        io_uring_sqe* sqe = &sqes[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = opcode;
+        sqe->user_data = userData;
+        sqArray[idx] = idx;
+        ++pending;
+        return sqe;
+    }
+
+    // Submits everything queued and calls done(user_data, res) for each completion
+    template <typename F>
+    bool run(F done) {
+        unsigned want = pending;
+        __atomic_store_n(sqTail, *sqTail + pending, __ATOMIC_RELEASE);
+        unsigned toSubmit = pending;
+        pending = 0;
+
+        unsigned got = 0;
+        while (got < want) {
+            int n = static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, want - got,
+                                               IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                broken = true;
+                return false;
+            }
+            toSubmit -= static_cast<unsigned>(n) < toSubmit ? static_cast<unsigned>(n) : toSubmit;
+
+            unsigned head = *cqHead;
+            unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head, ++got) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                done(cqe.user_data, cqe.res);
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+        return true;
+    }
+
+private:
+    // Sparse table of direct descriptors, so open, read and close of one file
+    // can be linked in a single submission (5.19+)
+    bool registerSlots() {
+        io_uring_rsrc_register reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.nr = SLOTS;
+        reg.flags = IORING_RSRC_REGISTER_SPARSE;
+        return ::syscall(__NR_io_uring_register, fd, IORING_REGISTER_FILES2, &reg, sizeof(reg)) == 0;
+    }
+
+    bool supportsOps() {
+        // IORING_REGISTER_PROBE exists since 5.6, the same release that added
+        // OPENAT/READ/CLOSE, so an old kernel just fails here
+        size_t len = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+        std::string buf(len, '\0');
+        auto* probe = reinterpret_cast<io_uring_probe*>(&buf[0]);
+        if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) < 0) return false;
+
+        for (int op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    int fd = -1;
+    void* sqPtr = nullptr;
+    void* cqPtr = nullptr;
+    size_t sqSize = 0, cqSize = 0, sqesSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned sqMask = 0, cqMask = 0, entries = 0;
+    unsigned pending = 0;
+};
+
+// Created on first use and kept for the whole run, nullptr if unavailable
+Ring* sharedRing() {
+    static Ring ring;
+    static bool ok = ring.init();
+    return ok && !ring.broken ? &ring : nullptr;
+}
+#endif
+} // namespace
+
+bool uringAvailable() {
+#ifdef BAREINFO_HAVE_IO_URING
+    return sharedRing() != nullptr;
+#else
+    return false;
+#endif
+}
+
+void readFilesSequential(std::vector<FileRead>& files) {
+    for (FileRead& f : files) {
+        f.data.clear();
+        int fd = ::open(f.path.c_str(), O_RDONLY | O_CLOEXEC);
+        f.ok = fd >= 0 && finishRead(fd, f.data);
+        if (fd >= 0) {
+            ::close(fd);
+            ++ioCounters().filesOpened;
+        }
+        ioCounters().bytesRead += f.data.size();
+    }
+}
+
+bool readFilesUring(std::vector<FileRead>& files) {
+#ifdef BAREINFO_HAVE_IO_URING
+    Ring* ring = sharedRing();
+    if (!ring) return false;
+
+    // user_data is the file index times 4 plus the step
+    enum Step : __u64 { OPEN = 0, READ = 1, CLOSE = 2 };
+
+    for (size_t start = 0; start < files.size(); start += ring->capacity()) {
+        size_t end = start + ring->capacity();
+        if (end > files.size()) end = files.size();
+
+        // open -> read -> close as one chain per file, in a direct descriptor
+        // slot. A failed open cancels the rest of its chain, the close is
+        // hard linked so it also runs when the read fails.
+        for (size_t i = start; i < end; ++i) {
+            FileRead& f = files[i];
+            unsigned slot = static_cast<unsigned>(i - start);
+            f.ok = false;
+            f.data.resize(FIRST_READ);
+
+            io_uring_sqe* open = ring->next(IORING_OP_OPENAT, i * 4 + OPEN);
+            open->fd = AT_FDCWD;
+            open->addr = reinterpret_cast<__u64>(f.path.c_str());
+            open->open_flags = O_RDONLY; // direct descriptors reject O_CLOEXEC
+            open->file_index = slot + 1;
+            open->flags = IOSQE_IO_LINK;
+
+            io_uring_sqe* read = ring->next(IORING_OP_READ, i * 4 + READ);
+            read->fd = static_cast<__s32>(slot);
+            read->addr = reinterpret_cast<__u64>(&f.data[0]);
+            read->len = FIRST_READ;
+            read->off = 0;
+            read->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+
+            io_uring_sqe* close = ring->next(IORING_OP_CLOSE, i * 4 + CLOSE);
+            close->file_index = slot + 1;
+        }
+
+        std::vector<size_t> tooBig;
+        IOCounters before = ioCounters();
+        bool ok = ring->run([&](__u64 data, int res) {
+            if ((data & 3) == OPEN && res >= 0) ++ioCounters().filesOpened;
+            if ((data & 3) != READ) return;
+            FileRead& f = files[data / 4];
+            if (res < 0) return;
+            ioCounters().bytesRead += static_cast<uint64_t>(res);
+            f.data.resize(static_cast<size_t>(res));
+            f.ok = true;
+            if (static_cast<size_t>(res) == FIRST_READ) tooBig.push_back(data / 4);
+        });
+
+        if (!ok) {
+            // The ring broke half way, do the rest the slow way. Moving the
+            // strings out keeps their heap buffers (FIRST_READ is past the
+            // small string size) where in-flight reads can still land.
+            for (size_t i = start; i < end; ++i) {
+                ring->abandon(std::move(files[i].data));
+                files[i].data = std::string();
+            }
+            ioCounters() = before;  // the sequential pass counts these files again
+            std::vector<FileRead> rest(files.begin() + start, files.end());
+            readFilesSequential(rest);
+            std::move(rest.begin(), rest.end(), files.begin() + start);
+            return true;
+        }
+
+        // The slot is already closed, so read files longer than a page again.
+        // readFile() counts the open and the whole file, drop the first read.
+        ioCounters().filesOpened -= tooBig.size();
+        ioCounters().bytesRead -= tooBig.size() * FIRST_READ;
+        for (size_t i : tooBig) files[i].ok = readFile(files[i].path, files[i].data);
+        for (size_t i = start; i < end; ++i) {
+            if (!files[i].ok) files[i].data.clear();
+        }
+    }
+    return true;
+#else
+    (void)files;
+    return false;
+#endif
+}
+
+void readFiles(std::vector<FileRead>& files) {
+    if (uringRequested() && files.size() >= URING_MIN_FILES && readFilesUring(files)) return;
+    readFilesSequential(files);
+}
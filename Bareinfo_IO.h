@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "Bareinfo_Core.h"
+
+// =============================
+// BATCHED FILE READS
+// =============================
+// readFiles() (Bareinfo_Core.h) reads a whole collection pass at once. The
+// io_uring backend queues an open -> read -> close chain for every file of
+// the batch and submits them with one syscall, instead of three syscalls per
+// file. It is opt in (BAREINFO_IO=uring) because it only pays off where
+// syscalls are expensive, run bareinfo_iobench to check a host. Without
+// io_uring (kernel older than 5.19, seccomp, io_uring_disabled, or built
+// without it) the files are read one after another with pread.
+
+// True if this build has io_uring support and the kernel lets us use it
+bool uringAvailable();
+
+void readFilesSequential(std::vector<FileRead>& files);
+
+// Returns false without touching the files if io_uring can't be used
+bool readFilesUring(std::vector<FileRead>& files);
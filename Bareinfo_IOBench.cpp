@@ -0,0 +1,135 @@
+// Compares the sequential and the io_uring readFiles backends on the files a
+// per CPU collection pass touches. By default it builds a fake sysfs-like
+// tree for 256 CPUs in /tmp, --root /sys/devices/system/cpu uses the real one.
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Bareinfo_Core.h"
+#include "Bareinfo_IO.h"
+
+static const char* PER_CPU_FILES[] = {
+    "cpufreq/scaling_governor", "cpufreq/energy_performance_preference", "cpufreq/scaling_driver",
+    "cpufreq/scaling_cur_freq", "cpufreq/scaling_min_freq", "cpufreq/scaling_max_freq",
+    "cpufreq/cpuinfo_min_freq", "cpufreq/cpuinfo_max_freq",
+    "topology/core_id", "topology/physical_package_id", "topology/die_id", "topology/cluster_id",
+    "cache/index0/level", "cache/index0/type", "cache/index0/size",
+    "cache/index1/level", "cache/index1/type", "cache/index1/size",
+    "cache/index2/level", "cache/index2/type", "cache/index2/size",
+    "cache/index3/level", "cache/index3/type", "cache/index3/size",
+};
+
+static bool writeFile(const std::string& path, const std::string& data) {
+    // mkdir -p for the parent directories
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        ::mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fputs(data.c_str(), f);
+    return std::fclose(f) == 0;
+}
+
+static std::string makeTree(int cpus) {
+    char dir[] = "/tmp/bareinfo-iobench-XXXXXX";
+    if (!::mkdtemp(dir)) return "";
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        std::string base = std::string(dir) + "/cpu" + std::to_string(cpu) + "/";
+        for (const char* file : PER_CPU_FILES) {
+            if (!writeFile(base + file, "performance\n")) return "";
+        }
+    }
+    return dir;
+}
+
+static void removeTree(const std::string& dir) {
+    ::nftw(dir.c_str(), [](const char* path, const struct stat*, int, FTW*) { return ::remove(path); },
+           16, FTW_DEPTH | FTW_PHYS);
+}
+
+// Microseconds per pass, averaged over runs
+template <typename F>
+static double timePass(std::vector<FileRead>& files, int runs, F read) {
+    read(files); // warm the dentry cache
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) read(files);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / runs;
+}
+
+int main(int argc, char *argv[]) {
+    int cpus = 256;
+    int runs = 50;
+    std::string root;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--cpus" && i + 1 < argc) {
+            cpus = std::atoi(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::atoi(argv[++i]);
+        } else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else {
+            std::cerr << "Usage: bareinfo_iobench [--cpus N] [--runs N] [--root DIR]" << std::endl;
+            return 1;
+        }
+    }
+    if (cpus <= 0 || runs <= 0) {
+        std::cerr << "--cpus and --runs must be positive" << std::endl;
+        return 1;
+    }
+
+    bool synthetic = root.empty();
+    if (synthetic) {
+        root = makeTree(cpus);
+        if (root.empty()) {
+            std::cerr << "Can't create the test tree in /tmp" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<FileRead> files;
+    for (const std::string& name : listDirectory(root)) {
+        if (name.compare(0, 3, "cpu") != 0 || name.size() < 4 || !std::isdigit(static_cast<unsigned char>(name[3]))) continue;
+        for (const char* file : PER_CPU_FILES) files.push_back({root + "/" + name + "/" + file, "", false});
+    }
+
+    double seq = timePass(files, runs, readFilesSequential);
+    size_t okSeq = 0;
+    for (const FileRead& f : files) okSeq += f.ok;
+    std::vector<FileRead> expected = files;
+
+    std::cout << "Files per pass:  " << files.size() << " (" << okSeq << " readable)\n";
+    std::cout << "Runs:            " << runs << "\n";
+    std::cout << "sync (pread):    " << seq << " us/pass, " << seq / files.size() << " us/file\n";
+
+    if (!uringAvailable()) {
+        std::cout << "uring:           not available on this kernel/build\n";
+    } else {
+        double uring = timePass(files, runs, [](std::vector<FileRead>& f) { readFilesUring(f); });
+        std::cout << "uring:           " << uring << " us/pass, " << uring / files.size() << " us/file\n";
+        std::cout << "Speedup:         " << seq / uring << "x\n";
+
+        // Real sysfs values (scaling_cur_freq) change between passes
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (files[i].ok != expected[i].ok || (synthetic && files[i].data != expected[i].data)) {
+                std::cerr << "Mismatch reading " << files[i].path << std::endl;
+                if (synthetic) removeTree(root);
+                return 1;
+            }
+        }
+    }
+
+    if (synthetic) removeTree(root);
+    return 0;
+}
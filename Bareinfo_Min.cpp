@@ -0,0 +1,51 @@
+// Minimal front-end for the statically linked bareinfo_static binary.
+// It deliberately avoids <iostream>/<fstream> so that no stream or locale
+// initialisation runs at startup, output goes through one write(2) call.
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Bareinfo_Fields.h"
+
+static void writeAll(int fd, const std::string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+        if (n <= 0) return;
+        done += static_cast<size_t>(n);
+    }
+}
+
+static int fail(const char* what, const char* arg) {
+    std::string msg = what;
+    msg += arg;
+    msg += '\n';
+    writeAll(STDERR_FILENO, msg);
+    return 1;
+}
+
+// Supports the default summary and --fields a,b,c [--raw], which is what
+// scripts call in a loop
+int main(int argc, char *argv[]) {
+    std::vector<const Field*> fields;
+    bool raw = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--fields" && i + 1 < argc) {
+            std::string bad;
+            if (!parseFieldList(argv[++i], fields, bad)) return fail("Unknown field: ", bad.c_str());
+        } else if (arg == "--raw") {
+            raw = true;
+        } else {
+            return fail("Unknown argument: ", argv[i]);
+        }
+    }
+
+    if (fields.empty()) fields = allFields(Output::Text);
+
+    writeAll(STDOUT_FILENO, formatFields(fields, collectFields(fields), !raw, raw));
+    return 0;
+}
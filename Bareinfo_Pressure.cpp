@@ -0,0 +1,72 @@
+#include "Bareinfo_Pressure.h"
+#include "Bareinfo_Core.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// "some avg10=0.00 avg60=0.00 avg300=0.00 total=0"
+static bool parseLine(const char* line, PressureLine& out) {
+    const char* p;
+    if (!(p = std::strstr(line, "avg10="))) return false;
+    out.avg10 = std::strtod(p + 6, nullptr);
+    if (!(p = std::strstr(line, "avg60="))) return false;
+    out.avg60 = std::strtod(p + 6, nullptr);
+    if (!(p = std::strstr(line, "avg300="))) return false;
+    out.avg300 = std::strtod(p + 7, nullptr);
+    if (!(p = std::strstr(line, "total="))) return false;
+    out.total = std::strtoull(p + 6, nullptr, 10);
+    out.valid = true;
+    return true;
+}
+
+static std::string formatLine(const char* kind, const PressureLine& l) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%s avg10=%.2f avg60=%.2f total=%llu", kind, l.avg10, l.avg60,
+                  static_cast<unsigned long long>(l.total));
+    return buf;
+}
+
+static std::string lineJSON(const PressureLine& l) {
+    if (!l.valid) return "null";
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "{\"Avg10\":%.2f,\"Avg60\":%.2f,\"Avg300\":%.2f,\"Total\":%llu}", l.avg10,
+                  l.avg60, l.avg300, static_cast<unsigned long long>(l.total));
+    return buf;
+}
+
+bool parsePressure(const std::string& data, Pressure& out) {
+    out = Pressure();
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        if (end == std::string::npos) end = data.size();
+        std::string line = data.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (line.compare(0, 5, "some ") == 0) parseLine(line.c_str(), out.some);
+        else if (line.compare(0, 5, "full ") == 0) parseLine(line.c_str(), out.full);
+    }
+    return out.some.valid;
+}
+
+bool PressureInfo::get(const std::string& resource, Pressure& out) {
+    std::string data;
+    return readFile("/proc/pressure/" + resource, data) && parsePressure(data, out);
+}
+
+std::string PressureInfo::getSummary(const std::string& resource) {
+    Pressure p;
+    if (!get(resource, p)) return "N/A";
+
+    std::string summary = formatLine("some", p.some);
+    // cpu "full" is always zero at the system level, skip it unless it says something
+    if (p.full.valid && (resource != "cpu" || p.full.total)) summary += " | " + formatLine("full", p.full);
+    return summary;
+}
+
+std::string PressureInfo::getJSON(const std::string& resource) {
+    Pressure p;
+    if (!get(resource, p)) return "null";
+    return "{\"Some\":" + lineJSON(p.some) + ",\"Full\":" + lineJSON(p.full) + "}";
+}
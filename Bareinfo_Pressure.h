@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// =============================
+// PRESSURE STALL INFORMATION
+// =============================
+struct PressureLine {
+    bool valid = false;
+    double avg10 = 0, avg60 = 0, avg300 = 0;  // percent of wall time
+    uint64_t total = 0;                       // microseconds stalled since boot
+};
+
+struct Pressure {
+    PressureLine some;  // at least one task stalled
+    PressureLine full;  // all non-idle tasks stalled (not reported for cpu on old kernels)
+};
+
+// Parses the contents of /proc/pressure/<resource>
+bool parsePressure(const std::string& data, Pressure& out);
+
+class PressureInfo {
+public:
+    // resource is "cpu", "memory" or "io"
+    bool get(const std::string& resource, Pressure& out);
+
+    // "some avg10=0.00 avg60=0.00 total=123 | full avg10=..." or "N/A"
+    std::string getSummary(const std::string& resource);
+
+    // {"Some":{"Avg10":0.00,"Avg60":0.00,"Avg300":0.00,"Total":123},"Full":{...}}
+    // for the JSON outputs, "Full" is null when the kernel doesn't report it
+    // and the whole value is null without PSI
+    std::string getJSON(const std::string& resource);
+};
@@ -0,0 +1,180 @@
+#include "Bareinfo_Tuning.h"
+#include "Bareinfo_Core.h"
+
+#include <cctype>
+#include <map>
+
+namespace {
+const std::string CPU_DIR   = "/sys/devices/system/cpu/";
+const std::string VULN_DIR  = "/sys/devices/system/cpu/vulnerabilities/";
+const std::string PROC_KERN = "/proc/sys/kernel/";
+
+std::string trim(const std::string& s) {
+    size_t start = 0, end = s.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
+    while (end > start && std::isspace(static_cast<unsigned char>(s[end - 1]))) --end;
+    return s.substr(start, end - start);
+}
+
+// "always [madvise] never" -> "madvise"
+std::string selected(const std::string& s) {
+    size_t open = s.find('[');
+    size_t close = s.find(']', open);
+    if (open == std::string::npos || close == std::string::npos) return trim(s);
+    return s.substr(open + 1, close - open - 1);
+}
+
+bool isCpuDir(const std::string& name) {
+    if (name.size() < 4 || name.compare(0, 3, "cpu") != 0) return false;
+    for (size_t i = 3; i < name.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(name[i]))) return false;
+    }
+    return true;
+}
+
+// One setting and the files it is built from
+struct Probe {
+    std::string key;
+    size_t first;   // index into the read list
+    size_t count;
+    bool bracketed; // value is the [selected] entry of a sysfs choice list
+};
+} // namespace
+
+TuningProfile defaultTuningProfile() {
+    TuningProfile p;
+    p.name = "throughput-performance";
+    p.expected = {
+        {"cpu.governor", "performance"},
+        {"cpu.epp", "performance"},
+        {"mm.thp", "always"},
+        {"vm.swappiness", "10"},
+        {"vm.dirty_ratio", "40"},
+        {"vm.dirty_background_ratio", "10"},
+    };
+    return p;
+}
+
+bool loadTuningProfile(const std::string& path, TuningProfile& profile, std::string& error) {
+    std::string data;
+    if (!readFile(path, data)) {
+        error = "Can't read profile " + path;
+        return false;
+    }
+
+    profile.name = path;
+    profile.expected.clear();
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        if (end == std::string::npos) end = data.size();
+        std::string line = trim(data.substr(pos, end - pos));
+        pos = end + 1;
+
+        if (line.empty() || line[0] == '#') continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = "Bad profile line: " + line;
+            return false;
+        }
+        profile.expected.emplace_back(trim(line.substr(0, eq)), trim(line.substr(eq + 1)));
+    }
+    return true;
+}
+
+std::vector<TuningSetting> TuningInfo::collect(const TuningProfile& profile) {
+    std::vector<FileRead> reads;
+    std::vector<Probe> probes;
+
+    auto add = [&](const std::string& key, const std::vector<std::string>& paths, bool bracketed) {
+        probes.push_back({key, reads.size(), paths.size(), bracketed});
+        for (const std::string& path : paths) reads.push_back({path, "", false});
+    };
+
+    // Per CPU cpufreq files, summarised as "value (n CPUs)" when they differ
+    std::vector<std::string> governors, epps;
+    for (const std::string& name : listDirectory(CPU_DIR)) {
+        if (!isCpuDir(name)) continue;
+        governors.push_back(CPU_DIR + name + "/cpufreq/scaling_governor");
+        epps.push_back(CPU_DIR + name + "/cpufreq/energy_performance_preference");
+    }
+
+    add("kernel.cmdline", {"/proc/cmdline"}, false);
+    add("cpu.scaling_driver", {CPU_DIR + "cpu0/cpufreq/scaling_driver"}, false);
+    add("cpu.governor", governors, false);
+    add("cpu.epp", epps, false);
+    add("cpu.idle_driver", {CPU_DIR + "cpuidle/current_driver"}, false);
+    add("cpu.idle_governor", {CPU_DIR + "cpuidle/current_governor_ro"}, false);
+    add("cstate.intel_idle.max_cstate", {"/sys/module/intel_idle/parameters/max_cstate"}, false);
+    add("cstate.processor.max_cstate", {"/sys/module/processor/parameters/max_cstate"}, false);
+    add("mm.thp", {"/sys/kernel/mm/transparent_hugepage/enabled"}, true);
+    add("mm.thp_defrag", {"/sys/kernel/mm/transparent_hugepage/defrag"}, true);
+    add("vm.swappiness", {"/proc/sys/vm/swappiness"}, false);
+    add("vm.dirty_ratio", {"/proc/sys/vm/dirty_ratio"}, false);
+    add("vm.dirty_background_ratio", {"/proc/sys/vm/dirty_background_ratio"}, false);
+    for (const std::string& name : listDirectory(PROC_KERN)) {
+        if (name.compare(0, 6, "sched_") == 0) add("kernel." + name, {PROC_KERN + name}, false);
+    }
+    for (const std::string& name : listDirectory(VULN_DIR)) {
+        add("vuln." + name, {VULN_DIR + name}, false);
+    }
+
+    readFiles(reads);
+
+    std::map<std::string, std::string> expected(profile.expected.begin(), profile.expected.end());
+    std::vector<TuningSetting> settings;
+    settings.reserve(probes.size());
+
+    for (const Probe& probe : probes) {
+        // Count the distinct values, most settings have just one file
+        std::map<std::string, size_t> values;
+        for (size_t i = probe.first; i < probe.first + probe.count; ++i) {
+            if (!reads[i].ok) continue;
+            std::string v = probe.bracketed ? selected(reads[i].data) : trim(reads[i].data);
+            ++values[v];
+        }
+
+        TuningSetting s;
+        s.key = probe.key;
+        if (values.empty()) {
+            s.value = "N/A";
+        } else if (values.size() == 1) {
+            s.value = values.begin()->first;
+        } else {
+            for (const auto& [v, n] : values) {
+                if (!s.value.empty()) s.value += ", ";
+                s.value += v + " (" + std::to_string(n) + " CPUs)";
+            }
+        }
+
+        auto it = expected.find(s.key);
+        if (it != expected.end()) {
+            s.expected = it->second;
+            s.differs = s.value != "N/A" && s.value != s.expected;
+            expected.erase(it);
+        }
+        settings.push_back(s);
+    }
+
+    // Whatever is left matched nothing we read, most likely a typo in the
+    // profile, so it must not pass as a well tuned setting
+    for (const auto& [key, value] : expected) {
+        TuningSetting s;
+        s.key = key;
+        s.value = "unknown key";
+        s.expected = value;
+        s.differs = true;
+        settings.push_back(s);
+    }
+    return settings;
+}
+
+std::string TuningInfo::getSummary() {
+    std::string summary;
+    for (const TuningSetting& s : collect(defaultTuningProfile())) {
+        if (!s.differs) continue;
+        if (!summary.empty()) summary += ", ";
+        summary += s.key;
+    }
+    return summary.empty() ? "none" : summary;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// =============================
+// KERNEL TUNING
+// =============================
+
+// Expected values, as "key=value" lines. Keys are the TuningSetting keys,
+// e.g. "cpu.governor=performance" or "vm.swappiness=10".
+struct TuningProfile {
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> expected;
+};
+
+// Built in profile, matches tuned's throughput-performance
+TuningProfile defaultTuningProfile();
+
+// Loads a profile file, returns false and sets error if it can't be read
+bool loadTuningProfile(const std::string& path, TuningProfile& profile, std::string& error);
+
+struct TuningSetting {
+    std::string key;       // "cpu.governor", "vm.swappiness", "vuln.spectre_v2", ...
+    std::string value;     // "N/A" if the file doesn't exist
+    std::string expected;  // empty if the profile doesn't care
+    bool differs = false;
+};
+
+class TuningInfo {
+public:
+    // Reads /proc/cmdline, cpufreq, THP, vm.*, cpu vulnerabilities, C-state
+    // limits and kernel.sched_* in one batched pass. Profile keys that match
+    // none of them are added at the end with the value "unknown key".
+    std::vector<TuningSetting> collect(const TuningProfile& profile);
+
+    // Keys that differ from the default profile, or "none"
+    std::string getSummary();
+};
@@ -0,0 +1,343 @@
+#include "Bareinfo_Watch.h"
+#include "Bareinfo_Export.h"
+#include "Bareinfo_Fields.h"
+#include "Bareinfo_Pressure.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+volatile std::sig_atomic_t stopRequested = 0;
+volatile std::sig_atomic_t reportRequested = 0;
+
+void onStopSignal(int) {
+    stopRequested = 1;
+}
+
+void onReportSignal(int) {
+    reportRequested = 1;
+}
+
+// What each collector cost over every snapshot so far, for the SIGUSR1 report
+struct CollectorStats {
+    uint64_t runs = 0;
+    uint64_t cacheHits = 0;
+    uint64_t bytesRead = 0;
+    uint64_t filesOpened = 0;
+    uint64_t pathLookups = 0;
+    double totalMs = 0;
+    double maxMs = 0;
+};
+
+struct WatchState {
+    bool ndjson = false;
+    bool meta = false;  // _meta in every snapshot
+    uint64_t snapshots = 0;
+    std::vector<const Field*> fields;  // set once the output is known
+    std::vector<CollectorStats> stats;
+};
+
+bool parseDuration(const std::string& s, uint64_t& us) {
+    char* end = nullptr;
+    double value = std::strtod(s.c_str(), &end);
+    if (end == s.c_str() || value < 0) return false;
+
+    std::string unit = end;
+    if (unit.empty() || unit == "us") us = static_cast<uint64_t>(value);
+    else if (unit == "ms") us = static_cast<uint64_t>(value * 1000);
+    else if (unit == "s") us = static_cast<uint64_t>(value * 1000000);
+    else return false;
+    return true;
+}
+
+std::string formatDuration(uint64_t us) {
+    if (us % 1000000 == 0) return std::to_string(us / 1000000) + "s";
+    if (us % 1000 == 0) return std::to_string(us / 1000) + "ms";
+    return std::to_string(us) + "us";
+}
+
+struct Watched {
+    PressureTrigger trigger;
+    int fd = -1;              // PSI trigger fd, -1 when sampling instead
+    uint64_t lastTotal = 0;   // sampling fallback only
+    std::chrono::steady_clock::time_point lastCheck;
+};
+
+// Reads the some/full total of a resource, for the sampling fallback
+bool readTotal(const PressureTrigger& t, uint64_t& total) {
+    Pressure p;
+    if (!PressureInfo().get(t.resource, p)) return false;
+    const PressureLine& line = t.kind == "full" ? p.full : p.some;
+    total = line.total;
+    return line.valid;
+}
+
+void emitSnapshot(const PressureTrigger& t, WatchState& state) {
+    const std::vector<const Field*>& fields = state.fields;
+    std::vector<FieldMeta> costs;
+    std::vector<std::string> values = collectFields(fields, &costs);
+
+    ++state.snapshots;
+    for (size_t i = 0; i < costs.size(); ++i) {
+        CollectorStats& s = state.stats[i];
+        ++s.runs;
+        if (costs[i].cached) ++s.cacheHits;
+        s.bytesRead += costs[i].bytesRead;
+        s.filesOpened += costs[i].filesOpened;
+        s.pathLookups += costs[i].pathLookups;
+        s.totalMs += costs[i].wallMs;
+        if (costs[i].wallMs > s.maxMs) s.maxMs = costs[i].wallMs;
+    }
+
+    char when[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(when, sizeof(when), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    if (state.ndjson) {
+        // Same line as --ndjson with an extra Event section in front
+        std::string json = formatJSON(fields, values, false, state.meta ? &costs : nullptr);
+        json.insert(1, "\"Event\":{\"Time\":\"" + std::string(when) + "\",\"Resource\":\"" + t.resource +
+                       "\",\"Kind\":\"" + t.kind + "\",\"StallUs\":" + std::to_string(t.stallUs) +
+                       ",\"WindowUs\":" + std::to_string(t.windowUs) + "},");
+        std::cout << json << std::flush;
+        return;
+    }
+
+    std::cout << "=== " << when << ": " << t.resource << " " << t.kind << " stall over "
+              << formatDuration(t.stallUs) << " in " << formatDuration(t.windowUs) << " ===\n"
+              << formatFields(fields, values, isatty(STDOUT_FILENO), false);
+    if (state.meta) std::cout << formatMeta(fields, costs, isatty(STDOUT_FILENO));
+    std::cout << "\n" << std::flush;
+}
+
+// Prints the collector totals to stderr, so it never mixes with the snapshots
+void printReport(const WatchState& state) {
+    char line[256];
+    if (state.ndjson) {
+        std::string json = "{\"_meta\":{\"Snapshots\":" + std::to_string(state.snapshots) + ",\"Collectors\":{";
+        for (size_t i = 0; i < state.fields.size(); ++i) {
+            const CollectorStats& s = state.stats[i];
+            std::snprintf(line, sizeof(line),
+                          "%s\"%s\":{\"Runs\":%llu,\"CacheHits\":%llu,\"TotalMs\":%.3f,\"MaxMs\":%.3f,\"BytesRead\":%llu,\"FilesOpened\":%llu,\"PathLookups\":%llu}",
+                          i ? "," : "", state.fields[i]->name, static_cast<unsigned long long>(s.runs),
+                          static_cast<unsigned long long>(s.cacheHits), s.totalMs, s.maxMs,
+                          static_cast<unsigned long long>(s.bytesRead), static_cast<unsigned long long>(s.filesOpened),
+                          static_cast<unsigned long long>(s.pathLookups));
+            json += line;
+        }
+        json += "}}}\n";
+        std::cerr << json << std::flush;
+        return;
+    }
+
+    std::cerr << "_meta after " << state.snapshots << " snapshots:\n";
+    std::snprintf(line, sizeof(line), "  %-24s %6s %6s %10s %10s %10s %6s %7s\n", "collector", "runs", "cached",
+                  "avg ms", "max ms", "bytes", "files", "lookups");
+    std::cerr << line;
+    for (size_t i = 0; i < state.fields.size(); ++i) {
+        const CollectorStats& s = state.stats[i];
+        uint64_t measured = s.runs - s.cacheHits;
+        std::snprintf(line, sizeof(line), "  %-24s %6llu %6llu %10.3f %10.3f %10llu %6llu %7llu\n", state.fields[i]->name,
+                      static_cast<unsigned long long>(s.runs), static_cast<unsigned long long>(s.cacheHits),
+                      measured ? s.totalMs / measured : 0.0, s.maxMs,
+                      static_cast<unsigned long long>(s.bytesRead), static_cast<unsigned long long>(s.filesOpened),
+                      static_cast<unsigned long long>(s.pathLookups));
+        std::cerr << line;
+    }
+    std::cerr << std::flush;
+}
+} // namespace
+
+bool parseTrigger(const std::string& spec, PressureTrigger& out, std::string& error) {
+    std::vector<std::string> parts;
+    size_t pos = 0;
+    while (pos <= spec.size()) {
+        size_t end = spec.find(':', pos);
+        if (end == std::string::npos) end = spec.size();
+        parts.push_back(spec.substr(pos, end - pos));
+        pos = end + 1;
+    }
+
+    if (parts.size() != 4) {
+        error = "Trigger must look like memory:some:150ms:2s, got " + spec;
+        return false;
+    }
+    out.resource = parts[0];
+    out.kind = parts[1];
+    if (out.resource != "cpu" && out.resource != "memory" && out.resource != "io") {
+        error = "Unknown PSI resource: " + out.resource;
+        return false;
+    }
+    if (out.kind != "some" && out.kind != "full") {
+        error = "PSI kind must be some or full: " + out.kind;
+        return false;
+    }
+    if (!parseDuration(parts[2], out.stallUs) || !parseDuration(parts[3], out.windowUs) ||
+        out.stallUs == 0 || out.stallUs > out.windowUs) {
+        error = "Bad stall/window in trigger: " + spec;
+        return false;
+    }
+    return true;
+}
+
+int RunWatch(int argc, char* argv[]) {
+    std::vector<PressureTrigger> triggers;
+    WatchState state;
+    long count = 0;
+
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string error;
+        if (arg == "--trigger" && i + 1 < argc) {
+            PressureTrigger t;
+            if (!parseTrigger(argv[++i], t, error)) {
+                std::cerr << error << std::endl;
+                return 1;
+            }
+            triggers.push_back(t);
+        } else if (arg == "--ndjson") {
+            state.ndjson = true;
+        } else if (arg == "--meta") {
+            state.meta = true;
+        } else if (arg == "--count" && i + 1 < argc) {
+            count = std::atol(argv[++i]);
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    state.fields = allFields(state.ndjson ? Output::JSON : Output::Text);
+    state.stats.resize(state.fields.size());
+
+    // Unprivileged triggers need a window that is a multiple of 2s
+    if (triggers.empty()) {
+        triggers.push_back({"memory", "some", 200000, 2000000});
+        triggers.push_back({"io", "full", 200000, 2000000});
+    }
+
+    std::vector<Watched> watched;
+    for (const PressureTrigger& t : triggers) {
+        Watched w;
+        w.trigger = t;
+
+        std::string path = "/proc/pressure/" + t.resource;
+        std::string spec = t.kind + " " + std::to_string(t.stallUs) + " " + std::to_string(t.windowUs);
+        w.fd = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (w.fd >= 0 && ::write(w.fd, spec.c_str(), spec.size() + 1) < 0) {
+            int err = errno;
+            ::close(w.fd);
+            w.fd = -1;
+            errno = err;
+        }
+
+        if (w.fd < 0) {
+            // No trigger support (old kernel, no permission): sample the total every window
+            std::cerr << "Can't register a PSI trigger on " << path << " (" << std::strerror(errno)
+                      << "), checking it every " << formatDuration(t.windowUs) << " instead" << std::endl;
+            if (!readTotal(t, w.lastTotal)) {
+                std::cerr << "PSI isn't available on this kernel" << std::endl;
+                return 1;
+            }
+            w.lastCheck = std::chrono::steady_clock::now();
+        }
+        watched.push_back(w);
+    }
+
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onStopSignal;  // no SA_RESTART, so ppoll() returns EINTR
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    sa.sa_handler = onReportSignal;
+    sigaction(SIGUSR1, &sa, nullptr);
+
+    // The signals are only let through inside ppoll(). One that arrives
+    // while a snapshot is printed stays pending and wakes the next ppoll()
+    // right away, instead of waiting for the next stall.
+    sigset_t handled, waitMask;
+    sigemptyset(&handled);
+    sigaddset(&handled, SIGINT);
+    sigaddset(&handled, SIGTERM);
+    sigaddset(&handled, SIGUSR1);
+    sigset_t oldMask;
+    sigprocmask(SIG_BLOCK, &handled, &oldMask);
+    waitMask = oldMask;
+    sigdelset(&waitMask, SIGINT);
+    sigdelset(&waitMask, SIGTERM);
+    sigdelset(&waitMask, SIGUSR1);
+
+    // DMI, kernel and the rest of the stable fields are read on the first snapshot only
+    setFieldCache(true);
+
+    std::vector<pollfd> pfds;
+    std::vector<size_t> owners;
+    int timeoutMs = -1;
+    for (size_t i = 0; i < watched.size(); ++i) {
+        if (watched[i].fd >= 0) {
+            pfds.push_back({watched[i].fd, POLLPRI, 0});
+            owners.push_back(i);
+        } else {
+            int ms = static_cast<int>(watched[i].trigger.windowUs / 1000);
+            if (timeoutMs < 0 || ms < timeoutMs) timeoutMs = ms;
+        }
+    }
+
+    long events = 0;
+    int status = 0;
+    timespec timeout = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    while (!stopRequested && (count <= 0 || events < count)) {
+        int n = ::ppoll(pfds.data(), pfds.size(), timeoutMs < 0 ? nullptr : &timeout, &waitMask);
+        if (reportRequested) {
+            reportRequested = 0;
+            printReport(state);
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "ppoll failed: " << std::strerror(errno) << std::endl;
+            status = 1;
+            break;
+        }
+
+        for (size_t i = 0; i < pfds.size(); ++i) {
+            if (pfds[i].revents & POLLERR) {
+                std::cerr << "PSI monitor for " << watched[owners[i]].trigger.resource << " went away" << std::endl;
+                stopRequested = 1;
+                status = 1;
+            } else if (pfds[i].revents & POLLPRI) {
+                emitSnapshot(watched[owners[i]].trigger, state);
+                ++events;
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for (Watched& w : watched) {
+            if (w.fd >= 0 || now - w.lastCheck < std::chrono::microseconds(w.trigger.windowUs)) continue;
+            uint64_t total = 0;
+            if (!readTotal(w.trigger, total)) continue;
+            if (total - w.lastTotal >= w.trigger.stallUs) {
+                emitSnapshot(w.trigger, state);
+                ++events;
+            }
+            w.lastTotal = total;
+            w.lastCheck = now;
+        }
+    }
+
+    for (const Watched& w : watched) {
+        if (w.fd >= 0) ::close(w.fd);
+    }
+    sigprocmask(SIG_SETMASK, &oldMask, nullptr);
+    return status;
+}
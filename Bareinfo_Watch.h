@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// =============================
+// WATCH MODE
+// =============================
+// Registers PSI triggers (/proc/pressure/*) and sleeps in ppoll() until the
+// kernel reports a stall, then prints a full snapshot. Nothing is sampled
+// while the system is healthy. Stable fields are cached after the first
+// snapshot, and SIGUSR1 prints what every collector has cost so far.
+
+struct PressureTrigger {
+    std::string resource;   // cpu, memory or io
+    std::string kind;       // some or full
+    uint64_t stallUs = 0;   // fire when stalled this long...
+    uint64_t windowUs = 0;  // ...within this window
+};
+
+// Parses "memory:some:150ms:2s", durations take us, ms or s (default us)
+bool parseTrigger(const std::string& spec, PressureTrigger& out, std::string& error);
+
+// Runs "bareinfo --watch [--trigger spec]... [--ndjson] [--meta] [--count n]"
+int RunWatch(int argc, char* argv[]);